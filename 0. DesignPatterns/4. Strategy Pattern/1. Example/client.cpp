@@ -1,6 +1,7 @@
 #include "player.hpp"
 #include "strategy.hpp"
 #include "various_strategies.hpp"
+#include "variant_player.hpp"
 
 int main(){
     level1strategy level1;
@@ -11,6 +12,11 @@ int main(){
 
     p.printCurrentLevel();
 
+    // the same without virtual calls
+    VariantPlayer v;
+    v.setStrategy(level2);
+    v.printCurrentLevel();
+
     return 0;
 
 }
\ No newline at end of file
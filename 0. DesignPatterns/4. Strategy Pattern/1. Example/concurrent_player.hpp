@@ -0,0 +1,73 @@
+#include "strategy.hpp"
+#include "epoch_reclamation.hpp"
+#include <atomic>
+#include <memory>
+#include <iostream>
+
+using namespace::std;
+
+#ifndef CONCURRENT_PLAYER
+#define CONCURRENT_PLAYER
+// Player whose strategy can be changed from one thread while others attack with it.
+// The strategy is an atomic pointer. An attack loads it inside an EpochGuard and never
+// locks or waits. setStrategy swaps in the new strategy and retires the old one, which
+// is freed once no attack that might still be using it is running.
+// The player owns its strategies, so they are handed over as unique_ptr.
+// The loads are seq_cst so they cannot move before the guard's announcement, on x86
+// that is still a plain load.
+class ConcurrentPlayer{
+public:
+    ConcurrentPlayer(){
+        strategy = NULL;
+    }
+
+    ConcurrentPlayer(unique_ptr<strategyI> curStrategy){
+        strategy = curStrategy.release();
+    }
+
+    // no attack may run any more
+    ~ConcurrentPlayer(){
+        delete strategy.load();
+    }
+
+    ConcurrentPlayer(const ConcurrentPlayer&) = delete;
+    ConcurrentPlayer& operator=(const ConcurrentPlayer&) = delete;
+
+    void setStrategy(unique_ptr<strategyI> curStrategy){
+        strategyI* old = strategy.exchange(curStrategy.release());
+        Epochs::retire(old);
+    }
+
+    int playMeeleAttack(int a, int b){
+        EpochGuard guard;
+        return strategy.load()->meeleattack(a, b);
+    }
+
+    int playRangeAttack(int a, int b){
+        EpochGuard guard;
+        return strategy.load()->rangeattack(a, b);
+    }
+
+    void playMeeleAttackBatch(span<const int> a, span<const int> b, span<int> out){
+        EpochGuard guard;
+        strategy.load()->meeleattackBatch(a, b, out);
+    }
+
+    void playRangeAttackBatch(span<const int> a, span<const int> b, span<int> out){
+        EpochGuard guard;
+        strategy.load()->rangeattackBatch(a, b, out);
+    }
+
+    int getPlayingLevel(){
+        EpochGuard guard;
+        return strategy.load()->getPlayingLevel();
+    }
+
+    void printCurrentLevel(){
+        cout << "current level: " << getPlayingLevel() << endl;
+    }
+private:
+    atomic<strategyI*> strategy;
+};
+
+#endif
@@ -0,0 +1,151 @@
+#include <atomic>
+#include <vector>
+#include <mutex>
+#include <functional>
+#include <cstdint>
+#include <cstddef>
+
+using namespace::std;
+
+#ifndef EPOCH_RECLAMATION
+#define EPOCH_RECLAMATION
+// Epoch based reclamation: a way to free an object that other threads may still be
+// reading without making the readers take a lock.
+// A reader holds an EpochGuard while it uses shared pointers. The guard writes the
+// current global epoch into the thread's slot, which is two plain atomic stores, so
+// reading is wait free. A writer that unlinks an object hands it to retire(). The object
+// is freed once the global epoch has moved on twice since then, and the epoch only moves
+// on when every reader inside a guard has seen the current one. So no reader that could
+// have loaded the old pointer is still running by then.
+// Up to MAX_THREADS threads can read at the same time, a slot is given back when its
+// thread ends.
+class Epochs{
+    static const int MAX_THREADS = 256;
+
+    struct alignas(64) Slot{
+        atomic<uint64_t> epoch;     // 0 when the thread is not inside a guard
+        atomic<bool> used;
+
+        Slot(): epoch(0), used(false){}
+    };
+    struct Retired{
+        uint64_t epoch;
+        function<void()> free;
+    };
+    // the retired objects, freed at exit when nobody reads any more
+    struct RetiredList{
+        vector<Retired> objects;
+        ~RetiredList(){
+            for(Retired &object : objects) object.free();
+        }
+    };
+    // gives the slot back when its thread ends
+    struct Owner{
+        Slot* slot;
+        int depth;
+
+        Owner(){
+            this->slot = NULL;
+            this->depth = 0;
+        }
+
+        ~Owner(){
+            if(slot != NULL) slot->used.store(false, memory_order_release);
+        }
+    };
+
+    inline static Slot slots[MAX_THREADS];
+    inline static atomic<uint64_t> global{1};
+    inline static mutex retiredLock;
+    inline static RetiredList retired;
+    inline static thread_local Owner owner;
+
+    static Slot* mySlot(){
+        if(owner.slot == NULL){
+            for(int i=0; ; i = (i + 1) % MAX_THREADS){
+                bool expected = false;
+                if(!slots[i].used.load(memory_order_relaxed) && slots[i].used.compare_exchange_strong(expected, true)){
+                    owner.slot = &slots[i];
+                    break;
+                }
+            }
+        }
+        return owner.slot;
+    }
+
+    // moves the global epoch on when every reader inside a guard is at the current one
+    static bool tryAdvance(){
+        uint64_t current = global.load();
+        for(Slot &slot : slots){
+            uint64_t seen = slot.epoch.load();
+            if(seen != 0 && seen != current) return false;
+        }
+        return global.compare_exchange_strong(current, current + 1);
+    }
+
+    // frees what was retired two epochs ago or before, called with retiredLock held
+    static void collectLocked(){
+        tryAdvance();
+        uint64_t current = global.load();
+        size_t kept = 0;
+        for(size_t i=0; i<retired.objects.size(); ++i){
+            if(retired.objects[i].epoch + 2 <= current){
+                retired.objects[i].free();
+            }else{
+                retired.objects[kept++] = move(retired.objects[i]);
+            }
+        }
+        retired.objects.resize(kept);
+    }
+
+public:
+    static void enter(){
+        Owner& me = owner;
+        if(me.depth++ > 0) return;
+        // seq_cst, the announcement must be visible before any pointer is loaded
+        mySlot()->epoch.store(global.load());
+    }
+
+    static void leave(){
+        Owner& me = owner;
+        if(--me.depth > 0) return;
+        me.slot->epoch.store(0, memory_order_release);
+    }
+
+    // frees the object with delete once no reader can hold it any more
+    template<typename T>
+    static void retire(T* object){
+        if(object == NULL) return;
+        lock_guard<mutex> lock(retiredLock);
+        retired.objects.push_back(Retired{global.load(), [object]{ delete object; }});
+        collectLocked();
+    }
+
+    // tries to free retired objects without retiring a new one
+    static void collect(){
+        lock_guard<mutex> lock(retiredLock);
+        collectLocked();
+    }
+
+    static size_t pending(){
+        lock_guard<mutex> lock(retiredLock);
+        return retired.objects.size();
+    }
+};
+
+// Marks the scope in which shared pointers are read, guards can be nested
+class EpochGuard{
+public:
+    EpochGuard(){
+        Epochs::enter();
+    }
+
+    ~EpochGuard(){
+        Epochs::leave();
+    }
+
+    EpochGuard(const EpochGuard&) = delete;
+    EpochGuard& operator=(const EpochGuard&) = delete;
+};
+
+#endif
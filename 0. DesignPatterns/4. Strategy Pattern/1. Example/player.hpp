@@ -24,6 +24,15 @@ public:
         return strategy->rangeattack(a, b);
     }
 
+    // one virtual call for the whole wave, see strategyI::meeleattackBatch
+    void playMeeleAttackBatch(span<const int> a, span<const int> b, span<int> out){
+        strategy->meeleattackBatch(a, b, out);
+    }
+
+    void playRangeAttackBatch(span<const int> a, span<const int> b, span<int> out){
+        strategy->rangeattackBatch(a, b, out);
+    }
+
     void printCurrentLevel(){
         int curLevel = strategy->getPlayingLevel();
         cout << "current level: " << curLevel << endl;
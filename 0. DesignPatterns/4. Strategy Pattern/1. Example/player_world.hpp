@@ -0,0 +1,131 @@
+#include "strategy.hpp"
+#include <vector>
+#include <unordered_map>
+#include <utility>
+#include <cstddef>
+
+using namespace::std;
+
+#ifndef PLAYER_WORLD
+#define PLAYER_WORLD
+// Many players kept as columns instead of one Player object each. Players with the
+// same strategy share a bucket, their attack inputs and results are contiguous arrays
+// in it, so an attack wave is one batch call per strategy over hot memory and no
+// pointer is chased per player.
+// A player is named by the id addPlayer returns. Changing its strategy moves it to the
+// other bucket in O(1): the last player of its old bucket takes its place.
+class PlayerWorld{
+    struct Bucket{
+        strategyI* strategy;
+        vector<int> ids;
+        vector<int> power;      // a of the attack
+        vector<int> bonus;      // b of the attack
+        vector<int> damage;     // result of the last wave
+    };
+    struct Place{
+        int bucket;
+        int index;
+    };
+
+    vector<Bucket> buckets;
+    unordered_map<strategyI*, int> bucketOf;
+    vector<Place> places;       // by player id
+
+    int bucketFor(strategyI* strategy){
+        auto it = bucketOf.find(strategy);
+        if(it != bucketOf.end()) return it->second;
+        buckets.push_back(Bucket{strategy, {}, {}, {}, {}});
+        bucketOf[strategy] = buckets.size() - 1;
+        return buckets.size() - 1;
+    }
+
+    void put(int id, int bucketIndex, int power, int bonus, int damage){
+        Bucket& bucket = buckets[bucketIndex];
+        places[id] = Place{bucketIndex, (int)bucket.ids.size()};
+        bucket.ids.push_back(id);
+        bucket.power.push_back(power);
+        bucket.bonus.push_back(bonus);
+        bucket.damage.push_back(damage);
+    }
+
+    // takes the player out of its bucket, the last one of the bucket moves into its place
+    void take(int id){
+        Place place = places[id];
+        Bucket& bucket = buckets[place.bucket];
+        int last = bucket.ids.size() - 1;
+        if(place.index != last){
+            bucket.ids[place.index] = bucket.ids[last];
+            bucket.power[place.index] = bucket.power[last];
+            bucket.bonus[place.index] = bucket.bonus[last];
+            bucket.damage[place.index] = bucket.damage[last];
+            places[bucket.ids[place.index]].index = place.index;
+        }
+        bucket.ids.pop_back();
+        bucket.power.pop_back();
+        bucket.bonus.pop_back();
+        bucket.damage.pop_back();
+    }
+
+public:
+    PlayerWorld(){}
+
+    int addPlayer(strategyI* strategy, int power, int bonus){
+        int id = places.size();
+        places.push_back(Place{0, 0});
+        put(id, bucketFor(strategy), power, bonus, 0);
+        return id;
+    }
+
+    void setStrategy(int id, strategyI* strategy){
+        int to = bucketFor(strategy);
+        Place place = places[id];
+        if(place.bucket == to) return;
+        Bucket& from = buckets[place.bucket];
+        int power = from.power[place.index], bonus = from.bonus[place.index], damage = from.damage[place.index];
+        take(id);
+        put(id, to, power, bonus, damage);
+    }
+
+    void setStats(int id, int power, int bonus){
+        Place place = places[id];
+        buckets[place.bucket].power[place.index] = power;
+        buckets[place.bucket].bonus[place.index] = bonus;
+    }
+
+    strategyI* getStrategy(int id){
+        return buckets[places[id].bucket].strategy;
+    }
+
+    // damage of the player in the last wave
+    int getDamage(int id){
+        Place place = places[id];
+        return buckets[place.bucket].damage[place.index];
+    }
+
+    int getPlayers(){
+        return places.size();
+    }
+
+    // every player does a meele attack, one batch call per strategy
+    void meeleAttacks(){
+        for(Bucket &bucket : buckets){
+            bucket.strategy->meeleattackBatch(bucket.power, bucket.bonus, bucket.damage);
+        }
+    }
+
+    void rangeAttacks(){
+        for(Bucket &bucket : buckets){
+            bucket.strategy->rangeattackBatch(bucket.power, bucket.bonus, bucket.damage);
+        }
+    }
+
+    // calls visit(id, damage) for every player, bucket by bucket
+    template<typename Visit>
+    void forEachDamage(Visit visit){
+        for(Bucket &bucket : buckets){
+            for(size_t i=0; i<bucket.ids.size(); ++i) visit(bucket.ids[i], bucket.damage[i]);
+        }
+    }
+};
+
+#endif
@@ -1,5 +1,16 @@
 #ifndef STRATEGY_INTERFACE
 #define STRATEGY_INTERFACE
+#include <span>
+#include <cstddef>
+#include <stdexcept>
+
+// a, b and out of a batch attack must have the same length
+inline void checkAttackBatch(std::span<const int> a, std::span<const int> b, std::span<int> out){
+    if(a.size() != out.size() || b.size() != out.size()){
+        throw std::invalid_argument("attack batch: a, b and out differ in length");
+    }
+}
+
 // strategy class would be sort of an interface
 // It only defined those methods which we want to implement for various different strategies
 class strategyI{
@@ -7,6 +18,21 @@ public:
     virtual int meeleattack(int a, int b) = 0;
     virtual int rangeattack(int a, int b) = 0;
     virtual int getPlayingLevel() = 0; 
+
+    // A whole wave of attacks in one call: out[i] = meeleattack(a[i], b[i]) for every i,
+    // a, b and out have the same length or invalid_argument is thrown.
+    // The default just loops, strategies override it when they can do better.
+    virtual void meeleattackBatch(std::span<const int> a, std::span<const int> b, std::span<int> out){
+        checkAttackBatch(a, b, out);
+        for(size_t i=0; i<out.size(); ++i) out[i] = meeleattack(a[i], b[i]);
+    }
+
+    virtual void rangeattackBatch(std::span<const int> a, std::span<const int> b, std::span<int> out){
+        checkAttackBatch(a, b, out);
+        for(size_t i=0; i<out.size(); ++i) out[i] = rangeattack(a[i], b[i]);
+    }
+
+    virtual ~strategyI(){}
 };
 
-#endif
\ No newline at end of file
+#endif
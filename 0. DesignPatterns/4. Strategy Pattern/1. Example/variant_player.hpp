@@ -0,0 +1,51 @@
+#include "various_strategies.hpp"
+#include <variant>
+#include <iostream>
+
+using namespace::std;
+
+#ifndef VARIANT_PLAYER
+#define VARIANT_PLAYER
+// Same as Player, but the strategy is held by value in a variant instead of behind a
+// strategyI pointer. visit() picks the level with one switch and calls it on its own
+// (final) class, so the attack is not a virtual call and gets inlined.
+// The strategy can still be changed at runtime with setStrategy.
+using levelStrategy = variant<level1strategy, level2strategy, level3strategy>;
+
+class VariantPlayer{
+public:
+    VariantPlayer(){}
+
+    VariantPlayer(levelStrategy curStrategy){
+        this->strategy = curStrategy;
+    }
+
+    void setStrategy(levelStrategy curStrategy){
+        this->strategy = curStrategy;
+    }
+
+    int playMeeleAttack(int a, int b){
+        return visit([&](auto& level){ return level.meeleattack(a, b); }, strategy);
+    }
+
+    int playRangeAttack(int a, int b){
+        return visit([&](auto& level){ return level.rangeattack(a, b); }, strategy);
+    }
+
+    void playMeeleAttackBatch(span<const int> a, span<const int> b, span<int> out){
+        visit([&](auto& level){ level.meeleattackBatch(a, b, out); }, strategy);
+    }
+
+    void playRangeAttackBatch(span<const int> a, span<const int> b, span<int> out){
+        visit([&](auto& level){ level.rangeattackBatch(a, b, out); }, strategy);
+    }
+
+    void printCurrentLevel(){
+        int curLevel = visit([](auto& level){ return level.getPlayingLevel(); }, strategy);
+        cout << "current level: " << curLevel << endl;
+    }
+private:
+    levelStrategy strategy;
+};
+
+#endif
@@ -1,7 +1,8 @@
 #include "strategy.hpp"
+#include "attack_kernels.hpp"
 #ifndef STRATEGIES
 #define STRATEGIES
-class level1strategy: public strategyI{
+class level1strategy final: public strategyI{
 public:
     int meeleattack(int a, int b) override{
         return 1 * (a + b);
@@ -9,12 +10,18 @@ public:
     int rangeattack(int a, int b) override{
         return 1 * (a + b);
     }
+    void meeleattackBatch(std::span<const int> a, std::span<const int> b, std::span<int> out) override{
+        scaledSum<1>(a, b, out);
+    }
+    void rangeattackBatch(std::span<const int> a, std::span<const int> b, std::span<int> out) override{
+        scaledSum<1>(a, b, out);
+    }
     int getPlayingLevel() override{
         return 1;
     }
 };
 
-class level2strategy: public strategyI{
+class level2strategy final: public strategyI{
 public:
     int meeleattack(int a, int b) override{
         return 2 * (a + b);
@@ -22,12 +29,18 @@ public:
     int rangeattack(int a, int b) override{
         return 2 * (a + b);
     }
+    void meeleattackBatch(std::span<const int> a, std::span<const int> b, std::span<int> out) override{
+        scaledSum<2>(a, b, out);
+    }
+    void rangeattackBatch(std::span<const int> a, std::span<const int> b, std::span<int> out) override{
+        scaledSum<2>(a, b, out);
+    }
     int getPlayingLevel() override{
         return 2;
     }
 };
 
-class level3strategy: public strategyI{
+class level3strategy final: public strategyI{
 public:
     int meeleattack(int a, int b) override{
         return 3 * (a + b);
@@ -35,6 +48,12 @@ public:
     int rangeattack(int a, int b) override{
         return 3 * (a + b);
     }
+    void meeleattackBatch(std::span<const int> a, std::span<const int> b, std::span<int> out) override{
+        scaledSum<3>(a, b, out);
+    }
+    void rangeattackBatch(std::span<const int> a, std::span<const int> b, std::span<int> out) override{
+        scaledSum<3>(a, b, out);
+    }
     int getPlayingLevel() override{
         return 3;
     }
@@ -0,0 +1,237 @@
+#ifndef IDEMPOTENCY_CACHE
+#define IDEMPOTENCY_CACHE
+#include <string>
+#include <vector>
+#include <deque>
+#include <unordered_map>
+#include <algorithm>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <unistd.h>
+#include "paymentSystem.hpp"
+using namespace std;
+
+// Remembers the outcome of every payment by its payment id for a while, so a payment
+// submitted again (a retry after a timeout, a double click) gets the first outcome
+// back instead of paying twice.
+// The table is split into shards with their own lock, a lookup only takes the lock of
+// its shard. A shard keeps at most capacity / shards outcomes and drops the oldest
+// beyond that. Outcomes expire after the ttl.
+// Only successful payments are remembered, a failed one may be tried again. While a
+// payment is being made, a second submission with its id waits for it and gets its
+// outcome.
+// snapshot() writes the outcomes that have not expired into a file and load() reads
+// them back after a restart, expiry times are wall clock times so they survive.
+class IdempotencyCache{
+	static const uint32_t MAGIC = 0x4D454449;		// "IDEM"
+	static const uint32_t VERSION = 1;
+
+	typedef chrono::system_clock Clock;
+
+	struct Entry{
+		bool done;					// false while the first submission is being paid
+		PaymentResult result;
+		long long expiresAt;		// ms since the epoch
+	};
+	struct alignas(64) Shard{
+		mutex lock;
+		condition_variable completed;
+		unordered_map<string, Entry> entries;
+		deque<pair<string, long long>> order;	// done entries by expiry, may hold stale ones
+		size_t pending = 0;					// entries being paid, left out of the capacity
+	};
+
+	vector<Shard> shards;
+	size_t perShard;
+	long long ttlMs;
+
+	static long long nowMs(){
+		return chrono::duration_cast<chrono::milliseconds>(Clock::now().time_since_epoch()).count();
+	}
+
+	Shard& shardOf(const string& paymentId){
+		return shards[hash<string>()(paymentId) % shards.size()];
+	}
+
+	// drops the expired entries and the oldest beyond the capacity, lock held
+	void trim(Shard& shard, long long now){
+		while(!shard.order.empty()){
+			pair<string, long long>& oldest = shard.order.front();
+			if(oldest.second > now && shard.entries.size() - shard.pending <= perShard)	break;
+			auto it = shard.entries.find(oldest.first);
+			if(it != shard.entries.end() && it->second.done && it->second.expiresAt == oldest.second){
+				shard.entries.erase(it);
+			}
+			shard.order.pop_front();
+		}
+	}
+
+	void store(Shard& shard, const string& paymentId, PaymentResult result, long long expiresAt){
+		auto it = shard.entries.find(paymentId);
+		if(it != shard.entries.end() && !it->second.done)	shard.pending--;
+		shard.entries[paymentId] = Entry{true, result, expiresAt};
+		shard.order.push_back(make_pair(paymentId, expiresAt));
+		trim(shard, nowMs());
+	}
+
+	// The first submission of the id is through: its placeholder goes, the outcome is
+	// kept when it succeeded (null when pay() threw) and the waiting submissions wake up
+	void settle(Shard& shard, const string& paymentId, const PaymentResult* result){
+		{
+			lock_guard<mutex> held(shard.lock);
+			if(result != nullptr && result->done){
+				store(shard, paymentId, *result, nowMs() + ttlMs);
+			}else{
+				auto it = shard.entries.find(paymentId);
+				if(it != shard.entries.end() && !it->second.done){
+					shard.pending--;
+					shard.entries.erase(it);
+				}
+			}
+		}
+		shard.completed.notify_all();
+	}
+
+public:
+	IdempotencyCache(size_t capacity, chrono::milliseconds ttl, int shardCount = 16) : shards(max(shardCount, 1)){
+		this->perShard = max(capacity / shards.size(), (size_t)1);
+		this->ttlMs = ttl.count();
+	}
+
+	// The outcome of the payment with this id: the remembered one, else the one pay()
+	// returns. cached says which one it was. An exception from pay() goes to the
+	// caller, a submission waiting for it then pays itself.
+	template<typename Pay>
+	PaymentResult run(const string& paymentId, Pay pay, bool* cached = nullptr){
+		Shard& shard = shardOf(paymentId);
+		{
+			unique_lock<mutex> held(shard.lock);
+			while(true){
+				auto it = shard.entries.find(paymentId);
+				if(it == shard.entries.end() || (it->second.done && it->second.expiresAt <= nowMs())){
+					shard.entries[paymentId] = Entry{false, PaymentResult(), 0};
+					shard.pending++;
+					break;
+				}
+				if(it->second.done){
+					if(cached != nullptr)	*cached = true;
+					return it->second.result;
+				}
+				shard.completed.wait(held);
+			}
+		}
+		if(cached != nullptr)	*cached = false;
+		PaymentResult result;
+		try{
+			result = pay();
+		}catch(...){
+			settle(shard, paymentId, nullptr);		// the next submission pays again
+			throw;
+		}
+		settle(shard, paymentId, &result);
+		return result;
+	}
+
+	// the remembered outcome without paying, false when there is none
+	bool find(const string& paymentId, PaymentResult& result){
+		Shard& shard = shardOf(paymentId);
+		lock_guard<mutex> held(shard.lock);
+		auto it = shard.entries.find(paymentId);
+		if(it == shard.entries.end() || !it->second.done || it->second.expiresAt <= nowMs())	return false;
+		result = it->second.result;
+		return true;
+	}
+
+	size_t size(){
+		size_t count = 0;
+		for(Shard &shard : shards){
+			lock_guard<mutex> held(shard.lock);
+			count += shard.entries.size();
+		}
+		return count;
+	}
+
+	// Writes every outcome that has not expired into the file: a header, then per entry
+	// its expiry, mode, amount and id (ids up to 64KB). Written next to it and renamed, so a crash leaves
+	// the old snapshot.
+	bool snapshot(const string& path){
+		string bytes;
+		uint32_t header[2] = {MAGIC, VERSION};
+		bytes.append((const char*)header, sizeof(header));
+		long long now = nowMs();
+		for(Shard &shard : shards){
+			lock_guard<mutex> held(shard.lock);
+			for(auto &it : shard.entries){
+				const Entry& entry = it.second;
+				if(!entry.done || entry.expiresAt <= now || it.first.size() > UINT16_MAX)	continue;
+				int32_t fields[2] = {(int32_t)entry.result.mode, (int32_t)entry.result.amount};
+				uint16_t length = it.first.size();
+				bytes.append((const char*)&entry.expiresAt, sizeof(entry.expiresAt));
+				bytes.append((const char*)fields, sizeof(fields));
+				bytes.append((const char*)&length, sizeof(length));
+				bytes.append(it.first);
+			}
+		}
+		string temporary = path + ".tmp";
+		FILE* file = fopen(temporary.c_str(), "wb");
+		if(file == nullptr)	return false;
+		bool written = fwrite(bytes.data(), 1, bytes.size(), file) == bytes.size() && fflush(file) == 0
+					   && fsync(fileno(file)) == 0;
+		fclose(file);
+		return written && rename(temporary.c_str(), path.c_str()) == 0;
+	}
+
+	// Reads back a snapshot, skipping what expired meanwhile. Returns the entries
+	// loaded, 0 when the file is missing or not a snapshot.
+	size_t load(const string& path){
+		FILE* file = fopen(path.c_str(), "rb");
+		if(file == nullptr)	return 0;
+		string bytes;
+		char chunk[1 << 16];
+		size_t got;
+		while((got = fread(chunk, 1, sizeof(chunk), file)) > 0)	bytes.append(chunk, got);
+		fclose(file);
+		uint32_t header[2];
+		if(bytes.size() < sizeof(header))	return 0;
+		memcpy(header, bytes.data(), sizeof(header));
+		if(header[0] != MAGIC || header[1] != VERSION)	return 0;
+		struct Loaded{
+			long long expiresAt;
+			PaymentResult result;
+			string paymentId;
+		};
+		vector<Loaded> entries;
+		size_t pos = sizeof(header);
+		long long now = nowMs();
+		const size_t fixed = sizeof(long long) + 2 * sizeof(int32_t) + sizeof(uint16_t);
+		while(pos + fixed <= bytes.size()){
+			long long expiresAt;
+			int32_t fields[2];
+			uint16_t length;
+			memcpy(&expiresAt, bytes.data() + pos, sizeof(expiresAt));
+			memcpy(fields, bytes.data() + pos + sizeof(expiresAt), sizeof(fields));
+			memcpy(&length, bytes.data() + pos + sizeof(expiresAt) + sizeof(fields), sizeof(length));
+			pos += fixed;
+			if(pos + length > bytes.size())	break;		// torn tail
+			string paymentId = bytes.substr(pos, length);
+			pos += length;
+			if(expiresAt <= now || fields[0] < 0 || fields[0] >= PAYMENT_MODES)	continue;
+			entries.push_back(Loaded{expiresAt, PaymentResult{true, (PaymentMode)fields[0], fields[1]}, paymentId});
+		}
+		// a shard drops its entries oldest first, so they go in by expiry
+		sort(entries.begin(), entries.end(), [](const Loaded& a, const Loaded& b){ return a.expiresAt < b.expiresAt; });
+		for(Loaded &entry : entries){
+			Shard& shard = shardOf(entry.paymentId);
+			lock_guard<mutex> held(shard.lock);
+			store(shard, entry.paymentId, entry.result, entry.expiresAt);
+		}
+		size_t loaded = entries.size();
+		return loaded;
+	}
+};
+
+#endif
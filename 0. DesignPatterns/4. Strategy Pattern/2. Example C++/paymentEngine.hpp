@@ -0,0 +1,270 @@
+#ifndef PAYMENT_ENGINE
+#define PAYMENT_ENGINE
+#include <vector>
+#include <deque>
+#include <queue>
+#include <future>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <random>
+#include <memory>
+#include <algorithm>
+#include <exception>
+#include "paymentSystem.hpp"
+using namespace std;
+
+// How the engine talks to one gateway
+struct GatewayOptions{
+	int maxInFlight = 8;				// calls running at the same time
+	int batchSize = 1;					// payments per call, more than 1 coalesces them
+	chrono::milliseconds batchWait{0};	// how long a payment may wait for its batch to fill
+	int maxAttempts = 3;
+	chrono::milliseconds baseBackoff{10};	// before the first retry, doubled for each next one
+	chrono::milliseconds maxBackoff{1000};
+	int failureThreshold = 5;			// failures in a row that open the circuit
+	chrono::milliseconds openFor{500};	// payments fail at once for this long, then one is tried
+};
+
+struct GatewayStats{
+	long long submitted = 0;
+	long long calls = 0;		// calls to the IPayment
+	long long retries = 0;
+	long long rejected = 0;		// failed at once, the circuit was open
+	long long failed = 0;		// gave up, attempts or circuit
+	long long exceptions = 0;	// calls that threw, every payment of the call counts as failed
+};
+
+// Makes payments without the caller waiting for the gateway. submit() returns a future
+// of the result at once, the payment is made by the gateway's own threads.
+// In front of every IPayment sit:
+// - a limiter, maxInFlight threads so at most that many calls run at once,
+// - batching, with batchSize > 1 the ready payments go out together in one
+//   processPayments call, a payment waits at most batchWait for others to join,
+// - retries, a failed payment is tried again after a random wait of up to
+//   baseBackoff * 2^attempt (capped at maxBackoff), so retries do not come in waves,
+// - a circuit breaker, after failureThreshold failures in a row the gateway is left
+//   alone for openFor: its payments fail at once. Then a single payment is let through,
+//   its success closes the circuit and its failure opens it again.
+// The IPayment implementations must be safe to call from several threads. A call that
+// throws fails all of its payments, they are retried as usual and a payment that gives
+// up rethrows the exception from its future.
+// Destroying the engine waits for every submitted payment to finish.
+class PaymentEngine{
+	typedef chrono::steady_clock Clock;
+
+	struct Payment{
+		int amount;
+		int attempts;
+		Clock::time_point readyAt;		// when it was queued or may be retried
+		shared_ptr<promise<PaymentResult>> result;
+		exception_ptr error;			// of the last call, when it threw
+	};
+	struct LaterFirst{
+		bool operator()(const Payment& a, const Payment& b) const{
+			return a.readyAt > b.readyAt;
+		}
+	};
+	enum CircuitState{
+		CLOSED,
+		OPEN,
+		HALF_OPEN
+	};
+
+	struct Gateway{
+		PaymentMode mode;
+		IPayment* handler;
+		GatewayOptions options;
+		mutex lock;
+		condition_variable wake;
+		deque<Payment> ready;
+		priority_queue<Payment, vector<Payment>, LaterFirst> retrying;
+		CircuitState circuit = CLOSED;
+		int failuresInRow = 0;
+		Clock::time_point openUntil;
+		bool trialRunning = false;		// the one payment of a half open circuit
+		bool stopping = false;
+		mt19937 random;
+		GatewayStats stats;
+		vector<thread> workers;
+	};
+
+	unique_ptr<Gateway> gateways[PAYMENT_MODES];
+
+	static void finish(Gateway& gateway, Payment& payment, bool done){
+		if(!done)	gateway.stats.failed++;
+		if(!done && payment.error != nullptr){
+			payment.result->set_exception(payment.error);
+		}else{
+			payment.result->set_value(PaymentResult{done, gateway.mode, payment.amount});
+		}
+	}
+
+	static void retryOrFail(Gateway& gateway, Payment& payment){
+		payment.attempts++;
+		if(payment.attempts >= gateway.options.maxAttempts){
+			finish(gateway, payment, false);
+			return;
+		}
+		long long cap = gateway.options.baseBackoff.count() << min(payment.attempts - 1, 30);
+		cap = min(cap, (long long)gateway.options.maxBackoff.count());
+		uniform_int_distribution<long long> jitter(0, max(cap, 0LL));
+		payment.readyAt = Clock::now() + chrono::milliseconds(jitter(gateway.random));
+		gateway.stats.retries++;
+		gateway.retrying.push(payment);
+	}
+
+	// one call's outcome for the circuit, called with the lock held
+	static void record(Gateway& gateway, bool failed){
+		if(!failed){
+			gateway.failuresInRow = 0;
+			gateway.circuit = CLOSED;
+			return;
+		}
+		gateway.failuresInRow++;
+		if(gateway.circuit == HALF_OPEN || gateway.failuresInRow >= gateway.options.failureThreshold){
+			gateway.circuit = OPEN;
+			gateway.openUntil = Clock::now() + gateway.options.openFor;
+		}
+	}
+
+	static void work(Gateway& gateway){
+		vector<Payment> batch;
+		vector<int> amounts;
+		vector<PaymentResult> results;
+		unique_lock<mutex> held(gateway.lock);
+		while(true){
+			Clock::time_point now = Clock::now();
+			while(!gateway.retrying.empty() && gateway.retrying.top().readyAt <= now){
+				gateway.ready.push_back(gateway.retrying.top());
+				gateway.retrying.pop();
+			}
+			if(gateway.ready.empty()){
+				if(gateway.stopping && gateway.retrying.empty())	return;
+				if(gateway.retrying.empty()){
+					gateway.wake.wait(held);
+				}else{
+					gateway.wake.wait_until(held, gateway.retrying.top().readyAt);
+				}
+				continue;
+			}
+			// a batch that is not full yet waits for more, up to batchWait after its oldest payment
+			Clock::time_point batchDue = gateway.ready.front().readyAt + gateway.options.batchWait;
+			if((int)gateway.ready.size() < gateway.options.batchSize && now < batchDue && !gateway.stopping){
+				gateway.wake.wait_until(held, batchDue);
+				continue;
+			}
+			if(gateway.circuit == OPEN && now >= gateway.openUntil){
+				gateway.circuit = HALF_OPEN;
+			}
+			if(gateway.circuit == OPEN || (gateway.circuit == HALF_OPEN && gateway.trialRunning)){
+				if(gateway.circuit == HALF_OPEN){
+					gateway.wake.wait(held);
+					continue;
+				}
+				while(!gateway.ready.empty()){
+					gateway.stats.rejected++;
+					finish(gateway, gateway.ready.front(), false);
+					gateway.ready.pop_front();
+				}
+				continue;
+			}
+			bool trial = gateway.circuit == HALF_OPEN;
+			size_t take = trial ? 1 : min(gateway.ready.size(), (size_t)gateway.options.batchSize);
+			batch.assign(gateway.ready.begin(), gateway.ready.begin() + take);
+			gateway.ready.erase(gateway.ready.begin(), gateway.ready.begin() + take);
+			gateway.trialRunning = trial;
+			gateway.stats.calls++;
+			if(!gateway.ready.empty())	gateway.wake.notify_one();
+
+			held.unlock();
+			amounts.resize(take);
+			results.resize(take);
+			for(size_t i=0; i<take; ++i)	amounts[i] = batch[i].amount;
+			exception_ptr error;
+			try{
+				gateway.handler->processPayments(amounts.data(), take, results.data());
+			}catch(...){
+				error = current_exception();
+			}
+			held.lock();
+
+			if(error != nullptr)	gateway.stats.exceptions++;
+			bool failed = false;
+			for(size_t i=0; i<take; ++i){
+				batch[i].error = error;
+				if(error == nullptr && results[i].done){
+					finish(gateway, batch[i], true);
+				}else{
+					failed = true;
+					retryOrFail(gateway, batch[i]);
+				}
+			}
+			record(gateway, failed);
+			if(trial){
+				gateway.trialRunning = false;
+				gateway.wake.notify_all();
+			}
+		}
+	}
+
+public:
+	PaymentEngine(){}
+
+	PaymentEngine(const PaymentEngine&) = delete;
+	PaymentEngine& operator=(const PaymentEngine&) = delete;
+
+	~PaymentEngine(){
+		for(auto &gateway : gateways){
+			if(gateway == nullptr)	continue;
+			{
+				lock_guard<mutex> held(gateway->lock);
+				gateway->stopping = true;
+			}
+			gateway->wake.notify_all();
+			for(thread &worker : gateway->workers)	worker.join();
+		}
+	}
+
+	// The handler serves the mode from now on, must be called before its first payment.
+	// A mode gets one gateway, false when it already has one.
+	bool addGateway(PaymentMode mode, IPayment* handler, GatewayOptions options){
+		if(mode < 0 || mode >= PAYMENT_MODES || gateways[mode] != nullptr)	return false;
+		unique_ptr<Gateway> gateway(new Gateway());
+		gateway->mode = mode;
+		gateway->handler = handler;
+		gateway->options = options;
+		gateway->random.seed(random_device()());
+		for(int i=0; i<max(options.maxInFlight, 1); ++i){
+			gateway->workers.push_back(thread(work, ref(*gateway)));
+		}
+		gateways[mode] = move(gateway);
+		return true;
+	}
+
+	future<PaymentResult> submit(PaymentMode mode, int amount){
+		shared_ptr<promise<PaymentResult>> result(new promise<PaymentResult>());
+		future<PaymentResult> outcome = result->get_future();
+		if(mode < 0 || mode >= PAYMENT_MODES || gateways[mode] == nullptr){
+			result->set_value(PaymentResult{false, mode, amount});
+			return outcome;
+		}
+		Gateway& gateway = *gateways[mode];
+		{
+			lock_guard<mutex> held(gateway.lock);
+			gateway.stats.submitted++;
+			gateway.ready.push_back(Payment{amount, 0, Clock::now(), result, nullptr});
+		}
+		gateway.wake.notify_one();
+		return outcome;
+	}
+
+	GatewayStats getStats(PaymentMode mode){
+		if(gateways[mode] == nullptr)	return GatewayStats();
+		lock_guard<mutex> held(gateways[mode]->lock);
+		return gateways[mode]->stats;
+	}
+};
+
+#endif
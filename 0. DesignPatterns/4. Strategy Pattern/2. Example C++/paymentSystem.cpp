@@ -1,74 +1,54 @@
 #include <iostream>
 #include <string>
+#include "paymentSystem.hpp"
+#include "paymentEngine.hpp"
+#include "idempotencyCache.hpp"
 using namespace std;
 
-class IPayment{
-private:
-	virtual string makePayment(int) = 0;
-public:
-	string processPayment(int amount){
-		return makePayment(amount);
-	}
-};
-
-class UPIPayment : public IPayment {
-private:
-	string makePayment(int amount){
-		return "upi payment done: Rs" + to_string(amount);
-	}
-};
-
-class NEFTPayment : public IPayment{
-private:
-	string makePayment(int amount){
-		return "NEFT Payment done: Rs" + to_string(amount);
-	}
-};
-
-class PaymentSystem{
-	IPayment* curMode = nullptr;
-
-public:
-	PaymentSystem(){
-		curMode = nullptr;
-	}
-
-	bool makePayment(string mode, int amount){
-		if(mode == "upi"){
-			UPIPayment upiMode;
-			curMode = &upiMode;
-		}else if(mode == "neft"){
-			NEFTPayment neftMode;
-			curMode = &neftMode;
-		}else{
-			cout << "Invalid mode" << endl;
-			return false;
-		}
-		cout << curMode->processPayment(amount);
-		return true;
-	}
-};
-
 class Application{
 	int amount;
+	UPIPayment upi;
+	NEFTPayment neft;
+	PaymentEngine engine;
+	IdempotencyCache paid;
+	string cacheFile;
 
 public:
-	Application(){
+	Application(string cacheFile) : paid(100000, chrono::hours(24)){
 		amount = 0;
+		this->cacheFile = cacheFile;
+		if(!cacheFile.empty())	paid.load(cacheFile);
+		engine.addGateway(UPI, &upi, GatewayOptions());
+		GatewayOptions neftOptions;
+		neftOptions.maxInFlight = 2;
+		neftOptions.batchSize = 32;		// NEFT settles in batches anyway
+		neftOptions.batchWait = chrono::milliseconds(5);
+		engine.addGateway(NEFT, &neft, neftOptions);
+	}
+
+	~Application(){
+		if(!cacheFile.empty())	paid.snapshot(cacheFile);
 	}
 
 	void makePayment(){
-		PaymentSystem paymentSystem;
+		string paymentId = "order-1";	// Given by the caller, the same for every retry
 		string mode = "upi"; // Take from user
 		amount = 200;	// amount is calculated;
-		bool success = false;
-		do{
-			success = paymentSystem.makePayment(mode, amount);
-		}while(success!=true);
+		PaymentMode paymentMode;
+		if(!parseMode(mode, paymentMode)){
+			cout << "Invalid mode" << endl;
+			return;
+		}
+		// retries, backoff and the circuit breaker are the engine's job
+		bool cached = false;
+		PaymentResult result = paid.run(paymentId, [&]{ return engine.submit(paymentMode, amount).get(); }, &cached);
+		if(cached)	cout << "already paid, ";
+		cout << result.receipt();
 	}
 };
 
-int main(){
-	Application app;
+// the optional argument is a file remembering the payments made across runs
+int main(int argc, char* argv[]){
+	Application app(argc > 1 ? argv[1] : "");
 	app.makePayment();
-}
\ No newline at end of file
+}
@@ -0,0 +1,138 @@
+#ifndef PAYMENT_SYSTEM
+#define PAYMENT_SYSTEM
+#include <iostream>
+#include <string>
+#include <cstdio>
+#include <cstddef>
+using namespace std;
+
+enum PaymentMode{
+	UPI,
+	NEFT,
+	PAYMENT_MODES
+};
+
+// "upi" or "neft" to its mode, false for anything else
+inline bool parseMode(const string& name, PaymentMode& mode){
+	static const char* names[PAYMENT_MODES] = {"upi", "neft"};
+	for(int i=0; i<PAYMENT_MODES; ++i){
+		if(name == names[i]){
+			mode = (PaymentMode)i;
+			return true;
+		}
+	}
+	return false;
+}
+
+// Outcome of one payment, plain values so making a payment allocates nothing.
+// The receipt text is only built when somebody wants to read it.
+struct PaymentResult{
+	bool done;
+	PaymentMode mode;
+	int amount;
+
+	// writes the receipt into the buffer like snprintf, returns its length
+	int format(char* buffer, size_t size) const{
+		static const char* receipts[PAYMENT_MODES] = {"upi payment done: Rs", "NEFT Payment done: Rs"};
+		if(!done)	return snprintf(buffer, size, "payment failed: Rs%d", amount);
+		return snprintf(buffer, size, "%s%d", receipts[mode], amount);
+	}
+
+	string receipt() const{
+		char buffer[64];
+		format(buffer, sizeof(buffer));
+		return buffer;
+	}
+};
+
+class IPayment{
+private:
+	virtual PaymentResult makePayment(int) = 0;
+
+	// many payments in one submission to the gateway, the default makes them one by one
+	virtual void makePayments(const int* amounts, size_t count, PaymentResult* results){
+		for(size_t i=0; i<count; ++i)	results[i] = makePayment(amounts[i]);
+	}
+public:
+	PaymentResult processPayment(int amount){
+		return makePayment(amount);
+	}
+
+	void processPayments(const int* amounts, size_t count, PaymentResult* results){
+		makePayments(amounts, count, results);
+	}
+
+	virtual ~IPayment(){}
+};
+
+class UPIPayment : public IPayment {
+private:
+	PaymentResult makePayment(int amount){
+		return PaymentResult{true, UPI, amount};
+	}
+};
+
+class NEFTPayment : public IPayment{
+private:
+	PaymentResult makePayment(int amount){
+		return PaymentResult{true, NEFT, amount};
+	}
+};
+
+// The handler of every mode, looked up by the mode itself in O(1).
+// Handlers are not owned and must outlive the registry.
+class PaymentRegistry{
+	IPayment* handlers[PAYMENT_MODES];
+
+public:
+	PaymentRegistry(){
+		for(int i=0; i<PAYMENT_MODES; ++i)	handlers[i] = nullptr;
+	}
+
+	void add(PaymentMode mode, IPayment* handler){
+		handlers[mode] = handler;
+	}
+
+	// nullptr when the mode has no handler
+	IPayment* get(PaymentMode mode){
+		return mode >= 0 && mode < PAYMENT_MODES ? handlers[mode] : nullptr;
+	}
+};
+
+class PaymentSystem{
+	UPIPayment upiMode;
+	NEFTPayment neftMode;
+	PaymentRegistry registry;
+
+public:
+	PaymentSystem(){
+		registry.add(UPI, &upiMode);
+		registry.add(NEFT, &neftMode);
+	}
+
+	// puts another handler in place of the built in one of the mode
+	void setHandler(PaymentMode mode, IPayment* handler){
+		registry.add(mode, handler);
+	}
+
+	PaymentResult makePayment(PaymentMode mode, int amount){
+		IPayment* handler = registry.get(mode);
+		if(handler == nullptr)	return PaymentResult{false, mode, amount};
+		return handler->processPayment(amount);
+	}
+
+	bool makePayment(string mode, int amount){
+		PaymentMode paymentMode;
+		if(!parseMode(mode, paymentMode)){
+			cout << "Invalid mode" << endl;
+			return false;
+		}
+		PaymentResult result = makePayment(paymentMode, amount);
+		char receipt[64];
+		result.format(receipt, sizeof(receipt));
+		cout << receipt;
+		return result.done;
+	}
+};
+
+#endif
@@ -0,0 +1,27 @@
+#include <iostream>
+#include "macbook.hpp"
+#include "di_container.hpp"
+
+using namespace std;
+
+// The MacBook of the Dependency inversion example wired three ways
+int main(){
+	auto keyboard = make_shared<MechanicalKeyboard>();
+	auto mouse = make_shared<OpticalMouse>();
+	MacBook myMacBook(keyboard, mouse);
+	cout << "shared_ptr wiring: " << myMacBook.use() << endl;
+
+	Container<> container;
+	container.bind<IKeyboard, MechanicalKeyboard>();
+	container.bind<IMouse, OpticalMouse>();
+	{
+		Ref<WiredMacBook<>> wired = container.make<WiredMacBook<>>(container.get<IKeyboard>(), container.get<IMouse>());
+		Ref<WiredMacBook<>> second = container.make<WiredMacBook<>>(container.get<IKeyboard>(), container.get<IMouse>());
+		wired->use();
+		cout << "container wiring, keyboard and mouse shared: " << second->use() << endl;
+	}
+	BorrowingMacBook borrowing(container.use<IKeyboard>(), container.use<IMouse>());
+	cout << "borrowed from the container: " << borrowing.use() << endl;
+	cout << container.arenaBytes() << " bytes of arena" << endl;
+	return 0;
+}
@@ -0,0 +1,316 @@
+#ifndef SOLID_DI_CONTAINER
+#define SOLID_DI_CONTAINER
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <memory>
+#include <new>
+#include <utility>
+#include <cstddef>
+
+using namespace std;
+
+// How handles count their references: plain adds for a wiring used by one thread,
+// atomics when handles are copied on several threads
+struct SingleThreaded{
+	typedef long Count;
+
+	struct Lock{
+		void lock(){}
+		void unlock(){}
+	};
+
+	static void add(Count& count){
+		count++;
+	}
+
+	// true when that was the last reference
+	static bool release(Count& count){
+		return --count == 0;
+	}
+};
+
+struct MultiThreaded{
+	typedef atomic<long> Count;
+	typedef mutex Lock;
+
+	static void add(Count& count){
+		count.fetch_add(1, memory_order_relaxed);
+	}
+
+	static bool release(Count& count){
+		return count.fetch_sub(1, memory_order_acq_rel) == 1;
+	}
+};
+
+// Sits in front of every component in the arena, in place of a shared_ptr control block
+template<typename Policy>
+struct ComponentHeader{
+	typename Policy::Count references;
+	void (*destroy)(ComponentHeader*);
+	bool alive;
+};
+
+// Owning handle to a component of a Container, like shared_ptr but the count lives next
+// to the component in the arena and is only atomic with MultiThreaded. When the last
+// handle goes the component is destroyed, its memory goes back with the arena.
+// A handle must not outlive its Container.
+template<typename T, typename Policy = SingleThreaded>
+class Ref{
+	T* object;
+	ComponentHeader<Policy>* header;
+
+	template<typename, typename> friend class Ref;
+	template<typename> friend class Container;
+
+	Ref(T* object, ComponentHeader<Policy>* header){
+		this->object = object;
+		this->header = header;
+		if(header != nullptr)	Policy::add(header->references);
+	}
+
+	void release(){
+		if(header != nullptr && Policy::release(header->references)){
+			header->destroy(header);
+		}
+	}
+
+public:
+	Ref(){
+		this->object = nullptr;
+		this->header = nullptr;
+	}
+
+	Ref(const Ref& other) : Ref(other.object, other.header){}
+
+	// from a handle of a derived component, MechanicalKeyboard to IKeyboard
+	template<typename From>
+	Ref(const Ref<From, Policy>& other) : Ref(static_cast<T*>(other.object), other.header){}
+
+	Ref(Ref&& other) noexcept{
+		this->object = other.object;
+		this->header = other.header;
+		other.object = nullptr;
+		other.header = nullptr;
+	}
+
+	Ref& operator=(Ref other){
+		swap(object, other.object);
+		swap(header, other.header);
+		return *this;
+	}
+
+	~Ref(){
+		release();
+	}
+
+	T* get() const{
+		return object;
+	}
+
+	T* operator->() const{
+		return object;
+	}
+
+	T& operator*() const{
+		return *object;
+	}
+
+	explicit operator bool() const{
+		return object != nullptr;
+	}
+};
+
+// Dependency injection container for one wiring. Components are constructed in its
+// arena, a few big blocks instead of one heap allocation (and control block) each.
+// bind<IKeyboard, MechanicalKeyboard>() says which class serves an interface, get<I>()
+// builds it on the first call and hands out the same one afterwards. make<T>(args...)
+// builds a new component every time, it dies with its last handle. Its arena memory is
+// not reused though, it only goes back with the container: make() is for wiring done
+// once, a container that makes a component per request grows without bound.
+// Components ask for their dependencies in the constructor:
+//   container.make<MacBook>(container.get<IKeyboard>(), container.get<IMouse>())
+// Handles are Ref<T, Policy> (counted) or plain T* from use<I>() (not counted,
+// valid as long as the container).
+// With SingleThreaded (the default) the container and its handles belong to one thread.
+// With MultiThreaded the container may be used from several threads.
+template<typename Policy = SingleThreaded>
+class Container{
+	static const size_t BLOCK_SIZE = 64 * 1024;
+
+	typedef ComponentHeader<Policy> Header;
+
+	// a component as it sits in the arena, alive with no references once constructed
+	template<typename T>
+	struct Node : Header{
+		T object;
+
+		template<typename... Args>
+		Node(Args&&... args) : object(forward<Args>(args)...){
+			this->references = 0;
+			this->destroy = &destroyNode<T>;
+			this->alive = true;
+		}
+	};
+
+	struct Binding{
+		void* (*build)(Container&, Header*&) = nullptr;	// builds the implementation, returns it as the interface
+		void* object = nullptr;
+		Header* header = nullptr;
+	};
+
+	typename Policy::Lock lock;
+	vector<unique_ptr<char[]>> blocks;
+	char* current = nullptr;				// block being filled
+	size_t used = 0;						// of it
+	size_t heapBytes = 0;
+	vector<Header*> created;				// in order, destroyed in reverse
+	vector<Binding> bindings;				// by interfaceId
+
+	static atomic<size_t>& nextInterfaceId(){
+		static atomic<size_t> next(0);
+		return next;
+	}
+
+	template<typename Interface>
+	static size_t interfaceId(){
+		static const size_t id = nextInterfaceId().fetch_add(1);
+		return id;
+	}
+
+	static char* aligned(char* at, size_t alignment){
+		return at + (alignment - (size_t)at % alignment) % alignment;
+	}
+
+	// lock held
+	void* allocate(size_t size, size_t alignment){
+		if(size + alignment > BLOCK_SIZE){		// a component of its own size gets its own block
+			blocks.push_back(unique_ptr<char[]>(new char[size + alignment]));
+			heapBytes += size + alignment;
+			return aligned(blocks.back().get(), alignment);
+		}
+		if(current == nullptr || aligned(current + used, alignment) + size > current + BLOCK_SIZE){
+			blocks.push_back(unique_ptr<char[]>(new char[BLOCK_SIZE]));
+			heapBytes += BLOCK_SIZE;
+			current = blocks.back().get();
+			used = 0;
+		}
+		char* at = aligned(current + used, alignment);
+		used = at + size - current;
+		return at;
+	}
+
+	template<typename T>
+	static void destroyNode(Header* header){
+		Node<T>* node = static_cast<Node<T>*>(header);
+		node->object.~T();
+		node->alive = false;
+	}
+
+	// The component in the arena, with no references yet. It goes into created once its
+	// constructor is through, after what that constructor made itself, so it is destroyed
+	// before those. When the constructor throws the memory is left unused.
+	template<typename T, typename... Args>
+	Node<T>* construct(Args&&... args){
+		void* memory;
+		{
+			lock_guard<typename Policy::Lock> held(lock);
+			memory = allocate(sizeof(Node<T>), alignof(Node<T>));
+		}
+		Node<T>* node = new(memory) Node<T>(forward<Args>(args)...);
+		lock_guard<typename Policy::Lock> held(lock);
+		created.push_back(node);
+		return node;
+	}
+
+	Binding& bindingOf(size_t id){
+		if(bindings.size() <= id)	bindings.resize(id + 1);
+		return bindings[id];
+	}
+
+	template<typename Interface, typename Implementation>
+	static void* buildBinding(Container& container, Header*& header){
+		Node<Implementation>* node = container.construct<Implementation>();
+		Policy::add(node->references);		// the container's own reference
+		header = node;
+		return static_cast<Interface*>(&node->object);
+	}
+
+	// handle to the bound component of the interface, built on the first call
+	template<typename Interface>
+	Ref<Interface, Policy> resolve(){
+		void* (*build)(Container&, Header*&);
+		{
+			lock_guard<typename Policy::Lock> held(lock);
+			Binding& binding = bindingOf(interfaceId<Interface>());
+			if(binding.object != nullptr)	return Ref<Interface, Policy>((Interface*)binding.object, binding.header);
+			if(binding.build == nullptr)	return Ref<Interface, Policy>();
+			build = binding.build;
+		}
+		// built outside the lock, its constructor may resolve its own dependencies
+		Header* header = nullptr;
+		void* object = build(*this, header);
+		lock_guard<typename Policy::Lock> held(lock);
+		Binding& binding = bindingOf(interfaceId<Interface>());
+		if(binding.object == nullptr){
+			binding.object = object;
+			binding.header = header;
+		}else if(Policy::release(header->references)){
+			header->destroy(header);		// another thread was first
+		}
+		return Ref<Interface, Policy>((Interface*)binding.object, binding.header);
+	}
+
+public:
+	Container(){}
+
+	Container(const Container&) = delete;
+	Container& operator=(const Container&) = delete;
+
+	// drops the container's references, then destroys what is still alive newest first
+	~Container(){
+		for(Binding &binding : bindings){
+			if(binding.header != nullptr && Policy::release(binding.header->references)){
+				binding.header->destroy(binding.header);
+			}
+		}
+		for(size_t i=created.size(); i>0; --i){
+			if(created[i - 1]->alive)	created[i - 1]->destroy(created[i - 1]);
+		}
+	}
+
+	// Implementation serves Interface from now on, it must be default constructible.
+	// Binding again only affects get() calls that have not built the interface yet.
+	template<typename Interface, typename Implementation>
+	void bind(){
+		lock_guard<typename Policy::Lock> held(lock);
+		bindingOf(interfaceId<Interface>()).build = &buildBinding<Interface, Implementation>;
+	}
+
+	// counted handle to the one component bound to the interface, null when unbound
+	template<typename Interface>
+	Ref<Interface, Policy> get(){
+		return resolve<Interface>();
+	}
+
+	// the same component without counting, valid as long as the container
+	template<typename Interface>
+	Interface* use(){
+		return get<Interface>().get();
+	}
+
+	// a new component of its own, arguments go to its constructor
+	template<typename T, typename... Args>
+	Ref<T, Policy> make(Args&&... args){
+		Node<T>* node = construct<T>(forward<Args>(args)...);
+		return Ref<T, Policy>(&node->object, node);
+	}
+
+	// bytes taken from the heap for components
+	size_t arenaBytes(){
+		lock_guard<typename Policy::Lock> held(lock);
+		return heapBytes;
+	}
+};
+
+#endif
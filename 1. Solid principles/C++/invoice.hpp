@@ -0,0 +1,59 @@
+#ifndef SOLID_INVOICE
+#define SOLID_INVOICE
+#include <string>
+#include <cstdio>
+
+using namespace std;
+
+// The marker an invoice is for, as in "1. S - Single Responsibility.cpp"
+class Marker{
+public:
+	int colour;
+	string brand;
+
+	Marker(){
+		this->colour = 0;
+	}
+
+	Marker(int colour, string brand){
+		this->colour = colour;
+		this->brand = brand;
+	}
+};
+
+class Invoice{
+public:
+	long long id;
+	string customer;
+	Marker marker;
+	int quantity;
+	long long amount;		// paise, set when the bill is generated
+
+	Invoice(){
+		this->id = 0;
+		this->quantity = 0;
+		this->amount = 0;
+	}
+
+	Invoice(long long id, string customer, Marker marker, int quantity){
+		this->id = id;
+		this->customer = customer;
+		this->marker = marker;
+		this->quantity = quantity;
+		this->amount = 0;
+	}
+
+	// one line "id,customer,brand,colour,quantity,amount", appended to out
+	void appendRecord(string& out) const{
+		char numbers[96];
+		out += to_string(id);
+		out += ',';
+		out += customer;
+		out += ',';
+		out += marker.brand;
+		snprintf(numbers, sizeof(numbers), ",%d,%d,%lld\n", marker.colour, quantity, amount);
+		out += numbers;
+	}
+};
+
+#endif
@@ -0,0 +1,38 @@
+#include <iostream>
+#include <string>
+#include "invoice.hpp"
+#include "invoice_dao.hpp"
+
+using namespace std;
+
+// The Open/Closed example with real backends: the same invoices go to the database
+// and to a file, directly and through the BufferedInvoiceDao decorator
+int main(int argc, char* argv[]){
+	string fileName = argc > 1 ? argv[1] : "invoices.csv";
+	Database database(chrono::microseconds(100));
+	FileInvoiceDao file(fileName);
+	InvoiceDao* daos[] = {&database, &file};
+
+	for(InvoiceDao* dao : daos){
+		auto start = chrono::steady_clock::now();
+		for(int i=0; i<1000; ++i){
+			Invoice invoice(i, "customer" + to_string(i % 10), Marker(i % 3, "Camlin"), 1 + i % 5);
+			dao->save(&invoice);
+		}
+		auto direct = chrono::steady_clock::now();
+		{
+			BufferedInvoiceDao buffered(dao);
+			for(int i=1000; i<2000; ++i){
+				Invoice invoice(i, "customer" + to_string(i % 10), Marker(i % 3, "Camlin"), 1 + i % 5);
+				buffered.save(&invoice);
+			}
+			buffered.flush();
+		}
+		auto end = chrono::steady_clock::now();
+		cout << (dao == &database ? "database" : fileName) << ": 1000 saves "
+			 << chrono::duration_cast<chrono::microseconds>(direct - start).count() << "us, buffered "
+			 << chrono::duration_cast<chrono::microseconds>(end - direct).count() << "us" << endl;
+	}
+	cout << database.size() << " invoices in the database" << endl;
+	return 0;
+}
@@ -0,0 +1,229 @@
+#ifndef SOLID_INVOICE_DAO
+#define SOLID_INVOICE_DAO
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <chrono>
+#include <algorithm>
+#include <cstddef>
+#include <fcntl.h>
+#include <unistd.h>
+#include "invoice.hpp"
+
+using namespace std;
+
+// Where invoices are kept, "2. O - open for extension, closed for modification.cpp".
+// A new backend is a new class, nothing here changes.
+class InvoiceDao {
+public:
+	virtual void save(Invoice* invoice) = 0;
+
+	// many invoices in one go, backends override it when a batch is cheaper than
+	// that many saves
+	virtual void saveBatch(Invoice* invoices, size_t count){
+		for(size_t i=0; i<count; ++i)	save(&invoices[i]);
+	}
+
+	virtual ~InvoiceDao() = default;
+};
+
+// Stands in for a database: every call is one round trip of roundTrip, a batch
+// included, and the rows stay in memory
+class Database : public InvoiceDao {
+	mutex lock;
+	vector<Invoice> rows;
+	chrono::microseconds roundTrip;
+
+	void wait(){
+		if(roundTrip.count() > 0)	this_thread::sleep_for(roundTrip);
+	}
+
+public:
+	Database(chrono::microseconds roundTrip = chrono::microseconds(0)){
+		this->roundTrip = roundTrip;
+	}
+
+	void save(Invoice* invoice) override {
+		wait();
+		lock_guard<mutex> held(lock);
+		rows.push_back(*invoice);
+	}
+
+	void saveBatch(Invoice* invoices, size_t count) override {
+		wait();
+		lock_guard<mutex> held(lock);
+		rows.insert(rows.end(), invoices, invoices + count);
+	}
+
+	size_t size(){
+		lock_guard<mutex> held(lock);
+		return rows.size();
+	}
+};
+
+// One line per invoice appended to a file, see Invoice::appendRecord.
+// save() is one write() call, saveBatch() formats the whole batch and writes it with
+// one call too.
+class FileInvoiceDao : public InvoiceDao {
+	int fd;
+	mutex lock;
+	string batch;
+
+	void writeAll(const string& bytes){
+		size_t done = 0;
+		while(done < bytes.size()){
+			ssize_t written = ::write(fd, bytes.data() + done, bytes.size() - done);
+			if(written < 0){
+				cout << "WARNING: Invoices could not be written" << endl;
+				return;
+			}
+			done += written;
+		}
+	}
+
+public:
+	FileInvoiceDao(string fileName){
+		this->fd = ::open(fileName.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+		if(fd < 0)	cout << "WARNING: Cannot open " << fileName << endl;
+	}
+
+	FileInvoiceDao(const FileInvoiceDao&) = delete;
+	FileInvoiceDao& operator=(const FileInvoiceDao&) = delete;
+
+	~FileInvoiceDao(){
+		if(fd >= 0)	::close(fd);
+	}
+
+	void save(Invoice* invoice) override {
+		if(fd < 0)	return;
+		string record;
+		invoice->appendRecord(record);
+		lock_guard<mutex> held(lock);
+		writeAll(record);
+	}
+
+	void saveBatch(Invoice* invoices, size_t count) override {
+		if(fd < 0)	return;
+		lock_guard<mutex> held(lock);
+		batch.clear();
+		for(size_t i=0; i<count; ++i)	invoices[i].appendRecord(batch);
+		writeAll(batch);
+	}
+};
+
+// Decorator that makes save() cheap: the invoice is copied into a buffer and a
+// background thread hands the buffer to the backend with one saveBatch call, once
+// batchSize invoices are in or the oldest has waited maxDelay.
+// When maxBatches batches are waiting for a slow backend, save() blocks, so the buffer
+// cannot grow without bound. flush() returns once everything saved before it is in
+// the backend, the destructor flushes too.
+class BufferedInvoiceDao : public InvoiceDao {
+	InvoiceDao* backend;
+	size_t batchSize;
+	chrono::milliseconds maxDelay;
+	size_t maxBatches;
+
+	mutex lock;
+	condition_variable changed;
+	vector<Invoice> filling;
+	chrono::steady_clock::time_point fillingSince;
+	deque<vector<Invoice>> full;		// waiting for the writer
+	long long queued = 0;				// invoices given to save() so far
+	long long written = 0;				// of them in the backend
+	bool flushWanted = false;
+	bool stopping = false;
+	thread writer;
+
+	// moves the filling batch to the full ones, lock held
+	void seal(){
+		if(filling.empty())	return;
+		full.push_back(move(filling));
+		filling = vector<Invoice>();
+		filling.reserve(batchSize);
+		changed.notify_all();
+	}
+
+	void write(){
+		unique_lock<mutex> held(lock);
+		while(true){
+			if(full.empty()){
+				if(!filling.empty() && (flushWanted || stopping
+										|| chrono::steady_clock::now() >= fillingSince + maxDelay)){
+					seal();
+					continue;
+				}
+				if(stopping)	return;
+				if(filling.empty()){
+					changed.wait(held);
+				}else{
+					changed.wait_until(held, fillingSince + maxDelay);
+				}
+				continue;
+			}
+			vector<Invoice> batch = move(full.front());
+			full.pop_front();
+			changed.notify_all();		// room for a blocked save()
+			held.unlock();
+			backend->saveBatch(batch.data(), batch.size());
+			held.lock();
+			written += batch.size();
+			if(written == queued)	flushWanted = false;
+			changed.notify_all();
+		}
+	}
+
+public:
+	BufferedInvoiceDao(InvoiceDao* backend, size_t batchSize = 256,
+					   chrono::milliseconds maxDelay = chrono::milliseconds(10), size_t maxBatches = 4){
+		this->backend = backend;
+		this->batchSize = max(batchSize, (size_t)1);
+		this->maxDelay = maxDelay;
+		this->maxBatches = max(maxBatches, (size_t)1);
+		filling.reserve(this->batchSize);
+		writer = thread(&BufferedInvoiceDao::write, this);
+	}
+
+	BufferedInvoiceDao(const BufferedInvoiceDao&) = delete;
+	BufferedInvoiceDao& operator=(const BufferedInvoiceDao&) = delete;
+
+	~BufferedInvoiceDao(){
+		{
+			lock_guard<mutex> held(lock);
+			stopping = true;
+		}
+		changed.notify_all();
+		writer.join();
+	}
+
+	// the invoice is copied, the caller may change or free it afterwards
+	void save(Invoice* invoice) override {
+		unique_lock<mutex> held(lock);
+		changed.wait(held, [&]{ return full.size() < maxBatches; });
+		if(filling.empty()){
+			fillingSince = chrono::steady_clock::now();
+			changed.notify_all();		// the writer starts timing this batch
+		}
+		filling.push_back(*invoice);
+		queued++;
+		if(filling.size() >= batchSize)	seal();
+	}
+
+	void saveBatch(Invoice* invoices, size_t count) override {
+		for(size_t i=0; i<count; ++i)	save(&invoices[i]);
+	}
+
+	void flush(){
+		unique_lock<mutex> held(lock);
+		long long target = queued;
+		if(written >= target)	return;
+		flushWanted = true;
+		changed.notify_all();
+		changed.wait(held, [&]{ return written >= target; });
+	}
+};
+
+#endif
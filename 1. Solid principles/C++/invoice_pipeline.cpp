@@ -0,0 +1,33 @@
+#include <iostream>
+#include <string>
+#include <cstdlib>
+#include <atomic>
+#include "invoice_dao.hpp"
+#include "invoice_pipeline.hpp"
+
+using namespace std;
+
+// Month end: the invoices of every customer billed, printed and saved by the
+// InvoicePipeline, then the throughput of each stage.
+// invoice_pipeline [invoices] [bill threads] [print threads] [save threads]
+int main(int argc, char* argv[]){
+	long long invoices = argc > 1 ? atoll(argv[1]) : 1000000;
+	PipelineOptions options;
+	if(argc > 2)	options.billThreads = atoi(argv[2]);
+	if(argc > 3)	options.printThreads = atoi(argv[3]);
+	if(argc > 4)	options.saveThreads = atoi(argv[4]);
+
+	Database database(chrono::microseconds(200));
+	atomic<long long> printedBytes(0);
+	InvoicePipeline pipeline(&database, options, [&](const Invoice&, const string& text){
+		printedBytes += text.size();		// runs on every print thread
+	});
+	string brands[] = {"Camlin", "Faber-Castell", "Staedtler", "Luxor"};
+	for(long long i=0; i<invoices; ++i){
+		pipeline.submit(Invoice(i, "customer" + to_string(i % 1000), Marker(i % 5, brands[i % 4]), 1 + i % 12));
+	}
+	pipeline.stop();
+	cout << database.size() << " invoices saved, " << printedBytes.load() << " bytes printed" << endl;
+	cout << pipeline.report();
+	return 0;
+}
@@ -0,0 +1,255 @@
+#ifndef SOLID_INVOICE_PIPELINE
+#define SOLID_INVOICE_PIPELINE
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <functional>
+#include "bounded_queue.hpp"
+#include "invoice_stages.hpp"
+
+using namespace std;
+
+struct PipelineOptions{
+	int billThreads = 2;
+	int printThreads = 2;
+	int saveThreads = 1;
+	size_t queueSize = 4096;		// between two stages
+	size_t saveBatch = 256;			// invoices per saveBatch call of the DAO
+};
+
+// What a stage did so far. busySeconds is the time its threads spent on invoices,
+// neither waiting for one nor blocked on a full queue to the next stage
+// (blockedSeconds, the next stage is slower). So processed / busySeconds is what one
+// thread of the stage can do and the stage whose threads are busy all the time is the
+// one to scale.
+struct StageStats{
+	string name;
+	int threads;
+	long long processed;
+	double busySeconds;
+	double blockedSeconds;
+	double seconds;				// since the pipeline started, until it stopped
+
+	double perThread(){
+		return busySeconds > 0 ? processed / busySeconds : 0;
+	}
+
+	double utilisation(){
+		return seconds > 0 && threads > 0 ? busySeconds / (seconds * threads) : 0;
+	}
+
+	double blocked(){
+		return seconds > 0 && threads > 0 ? blockedSeconds / (seconds * threads) : 0;
+	}
+};
+
+// Runs the SRP classes as a pipeline, each stage with its own threads and a
+// BoundedQueue to the next one:
+//   submit (any thread) -> bill -> print -> save
+// Bill sets the amount with InvoiceBill, print renders the text with InvoicePrint and
+// hands it to onPrinted, save stores the invoices with InvoiceSaveDB a batch at a time.
+// A full queue holds the stage before it back, so a slow stage slows submit down
+// instead of piling invoices up in memory.
+class InvoicePipeline{
+	struct Job{
+		Invoice invoice;
+		string text;
+	};
+	struct Stage{
+		string name;
+		int threads;
+		atomic<long long> processed;
+		atomic<long long> idleNs;
+		atomic<long long> blockedNs;	// pushing into the full queue of the next stage
+	};
+
+	InvoiceBill bill;
+	InvoicePrint print;
+	InvoiceSaveDB saveDB;
+	PipelineOptions options;
+	function<void(const Invoice&, const string&)> onPrinted;
+	BoundedQueue<Job> intake;
+	BoundedQueue<Job> billed;
+	BoundedQueue<Job> printed;
+	Stage stages[3];
+	vector<thread> workers;
+	atomic<bool> stopping;
+	atomic<long long> submitted;
+	chrono::steady_clock::time_point started;
+	chrono::steady_clock::time_point ended;		// when stop() was done
+
+	static long long nowNs(){
+		return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	// spins first, then gives the core away, then sleeps while there is nothing to do
+	static void wait(int &idle){
+		idle++;
+		if(idle < 64){
+			return;
+		}else if(idle < 128){
+			this_thread::yield();
+		}else{
+			this_thread::sleep_for(chrono::microseconds(50));
+		}
+	}
+
+	// waits while the queue is full, the time goes to blockedNs when there is one
+	static void push(BoundedQueue<Job> &queue, Job &job, atomic<long long>* blockedNs = nullptr){
+		if(queue.tryPush(move(job)))	return;
+		long long since = nowNs();
+		int idle = 0;
+		while(!queue.tryPush(move(job))){
+			wait(idle);
+		}
+		if(blockedNs != nullptr)	blockedNs->fetch_add(nowNs() - since, memory_order_relaxed);
+	}
+
+	// Next job for a stage, false once the pipeline stops and the queue is empty.
+	// Time spent waiting is counted as idle for the stage.
+	bool next(BoundedQueue<Job> &queue, Stage &stage, Job &job, long long &idleSince){
+		int idle = 0;
+		while(!queue.tryPop(job)){
+			if(idleSince == 0)	idleSince = nowNs();
+			if(stopping.load()){
+				stage.idleNs.fetch_add(nowNs() - idleSince, memory_order_relaxed);
+				return false;
+			}
+			wait(idle);
+		}
+		if(idleSince != 0){
+			stage.idleNs.fetch_add(nowNs() - idleSince, memory_order_relaxed);
+			idleSince = 0;
+		}
+		return true;
+	}
+
+	void billing(){
+		Job job;
+		long long idleSince = 0;
+		while(next(intake, stages[0], job, idleSince)){
+			bill.generateBill(job.invoice);
+			stages[0].processed.fetch_add(1, memory_order_relaxed);
+			push(billed, job, &stages[0].blockedNs);
+		}
+	}
+
+	void printing(){
+		Job job;
+		long long idleSince = 0;
+		while(next(billed, stages[1], job, idleSince)){
+			job.text.clear();
+			print.printInvoice(job.invoice, job.text);
+			if(onPrinted)	onPrinted(job.invoice, job.text);
+			stages[1].processed.fetch_add(1, memory_order_relaxed);
+			push(printed, job, &stages[1].blockedNs);
+		}
+	}
+
+	void saving(){
+		Job job;
+		vector<Invoice> batch;
+		batch.reserve(options.saveBatch);
+		long long idleSince = 0;
+		while(next(printed, stages[2], job, idleSince)){
+			batch.push_back(move(job.invoice));
+			// takes what is already queued, up to a batch, without waiting for more
+			while(batch.size() < options.saveBatch && printed.tryPop(job))	batch.push_back(move(job.invoice));
+			saveDB.saveToDB(batch.data(), batch.size());
+			stages[2].processed.fetch_add(batch.size(), memory_order_release);
+			batch.clear();
+		}
+	}
+
+	void startStage(int index, string name, int threads, void (InvoicePipeline::*work)()){
+		stages[index].name = name;
+		stages[index].threads = max(threads, 1);
+		stages[index].processed = 0;
+		stages[index].idleNs = 0;
+		stages[index].blockedNs = 0;
+		for(int i=0; i<stages[index].threads; ++i)	workers.push_back(thread(work, this));
+	}
+
+public:
+	InvoicePipeline(InvoiceDao* dao, PipelineOptions options = PipelineOptions(),
+					function<void(const Invoice&, const string&)> onPrinted = nullptr)
+		: saveDB(dao), intake(options.queueSize), billed(options.queueSize), printed(options.queueSize){
+		this->options = options;
+		this->options.saveBatch = max(options.saveBatch, (size_t)1);
+		this->onPrinted = onPrinted;
+		this->stopping = false;
+		this->submitted = 0;
+		this->started = chrono::steady_clock::now();
+		startStage(0, "bill", options.billThreads, &InvoicePipeline::billing);
+		startStage(1, "print", options.printThreads, &InvoicePipeline::printing);
+		startStage(2, "save", options.saveThreads, &InvoicePipeline::saving);
+	}
+
+	InvoicePipeline(const InvoicePipeline&) = delete;
+	InvoicePipeline& operator=(const InvoicePipeline&) = delete;
+
+	~InvoicePipeline(){
+		stop();
+	}
+
+	// queues the invoice, waits while the intake queue is full
+	void submit(const Invoice& invoice){
+		Job job;
+		job.invoice = invoice;
+		submitted++;
+		push(intake, job);
+	}
+
+	// waits until every invoice submitted so far is saved
+	void drain(){
+		int idle = 0;
+		while(stages[2].processed.load(memory_order_acquire) < submitted.load()){
+			wait(idle);
+		}
+	}
+
+	// saves the invoices already submitted and stops the threads, submit must not run any more
+	void stop(){
+		if(workers.empty())	return;
+		drain();
+		stopping = true;
+		for(thread &worker : workers){
+			worker.join();
+		}
+		workers.clear();
+		ended = chrono::steady_clock::now();
+	}
+
+	// bill, print and save in that order. A thread waiting or blocked right now counts
+	// as busy until it gets its next invoice or hands this one on.
+	vector<StageStats> stats(){
+		chrono::steady_clock::time_point upTo = workers.empty() ? ended : chrono::steady_clock::now();
+		double seconds = chrono::duration<double>(upTo - started).count();
+		vector<StageStats> result;
+		for(Stage &stage : stages){
+			double blocked = stage.blockedNs.load(memory_order_relaxed) * 1e-9;
+			double busy = seconds * stage.threads - stage.idleNs.load(memory_order_relaxed) * 1e-9 - blocked;
+			result.push_back(StageStats{stage.name, stage.threads, stage.processed.load(memory_order_relaxed),
+										max(busy, 0.0), blocked, seconds});
+		}
+		return result;
+	}
+
+	// one line per stage, the busiest stage is the one to give more threads
+	string report(){
+		string text;
+		char line[160];
+		for(StageStats &stage : stats()){
+			snprintf(line, sizeof(line), "%-6s %2d threads %10lld invoices %12.0f/s per thread %5.1f%% busy %5.1f%% blocked\n",
+					 stage.name.c_str(), stage.threads, stage.processed, stage.perThread(), stage.utilisation() * 100,
+					 stage.blocked() * 100);
+			text += line;
+		}
+		return text;
+	}
+};
+
+#endif
@@ -0,0 +1,65 @@
+#ifndef SOLID_INVOICE_STAGES
+#define SOLID_INVOICE_STAGES
+#include <string>
+#include <cstdio>
+#include <cstddef>
+#include "invoice.hpp"
+#include "invoice_dao.hpp"
+
+using namespace std;
+
+// The three classes of "1. S - Single Responsibility.cpp", each with its one job.
+// They keep no state between invoices, so one object can serve several threads.
+
+class InvoiceBill{
+public:
+	static const int GST_PERCENT = 18;
+
+	// price of one marker in paise
+	static long long unitPrice(const Marker& marker){
+		long long price = 2500 + 500 * (marker.colour % 4);
+		for(char c : marker.brand)	price += (unsigned char)c % 7;
+		return price;
+	}
+
+	void generateBill(Invoice& invoice){
+		long long net = unitPrice(invoice.marker) * invoice.quantity;
+		invoice.amount = net + net * GST_PERCENT / 100;
+	}
+};
+
+class InvoicePrint{
+public:
+	// the printable invoice, appended to out
+	void printInvoice(const Invoice& invoice, string& out){
+		char text[512];
+		long long unit = InvoiceBill::unitPrice(invoice.marker);
+		long long net = unit * invoice.quantity;
+		int length = snprintf(text, sizeof(text),
+			"INVOICE #%lld\n"
+			"Customer: %s\n"
+			"Item: %s marker, colour %d x %d @ Rs %lld.%02lld\n"
+			"Net: Rs %lld.%02lld  GST %d%%: Rs %lld.%02lld\n"
+			"Total: Rs %lld.%02lld\n",
+			invoice.id, invoice.customer.c_str(), invoice.marker.brand.c_str(), invoice.marker.colour,
+			invoice.quantity, unit / 100, unit % 100,
+			net / 100, net % 100, InvoiceBill::GST_PERCENT, (invoice.amount - net) / 100, (invoice.amount - net) % 100,
+			invoice.amount / 100, invoice.amount % 100);
+		out.append(text, min(length, (int)sizeof(text) - 1));
+	}
+};
+
+class InvoiceSaveDB{
+	InvoiceDao* dao;
+
+public:
+	InvoiceSaveDB(InvoiceDao* dao){
+		this->dao = dao;
+	}
+
+	void saveToDB(Invoice* invoices, size_t count){
+		dao->saveBatch(invoices, count);
+	}
+};
+
+#endif
@@ -0,0 +1,88 @@
+#ifndef SOLID_MACBOOK
+#define SOLID_MACBOOK
+#include <memory>
+#include "di_container.hpp"
+
+using namespace std;
+
+// The example of "5. Dependency inversion.cpp": a MacBook depends on the IKeyboard and
+// IMouse interfaces only, never on the classes behind them
+
+class IKeyboard {
+public:
+	virtual ~IKeyboard() = default;
+	virtual int type() const = 0;		// keys typed so far
+};
+
+class IMouse {
+public:
+	virtual ~IMouse() = default;
+	virtual int click() const = 0;
+};
+
+class MechanicalKeyboard : public IKeyboard {
+	mutable int keys = 0;
+
+public:
+	int type() const override {
+		return ++keys;
+	}
+};
+
+class OpticalMouse : public IMouse {
+	mutable int clicks = 0;
+
+public:
+	int click() const override {
+		return ++clicks;
+	}
+};
+
+// Wired with shared_ptr as in the example
+class MacBook {
+public:
+	MacBook(shared_ptr<IKeyboard> keyboard, shared_ptr<IMouse> mouse)
+		: keyboard(move(keyboard)), mouse(move(mouse)) {}
+
+	int use() const{
+		return keyboard->type() + mouse->click();
+	}
+
+private:
+	shared_ptr<IKeyboard> keyboard;
+	shared_ptr<IMouse> mouse;
+};
+
+// Wired by a Container, the handles count without a control block or, with
+// SingleThreaded, without atomics
+template<typename Policy = SingleThreaded>
+class WiredMacBook {
+public:
+	WiredMacBook(Ref<IKeyboard, Policy> keyboard, Ref<IMouse, Policy> mouse)
+		: keyboard(move(keyboard)), mouse(move(mouse)) {}
+
+	int use() const{
+		return keyboard->type() + mouse->click();
+	}
+
+private:
+	Ref<IKeyboard, Policy> keyboard;
+	Ref<IMouse, Policy> mouse;
+};
+
+// With plain pointers from Container::use(), for a MacBook that never outlives its wiring
+class BorrowingMacBook {
+public:
+	BorrowingMacBook(IKeyboard* keyboard, IMouse* mouse)
+		: keyboard(keyboard), mouse(mouse) {}
+
+	int use() const{
+		return keyboard->type() + mouse->click();
+	}
+
+private:
+	IKeyboard* keyboard;
+	IMouse* mouse;
+};
+
+#endif
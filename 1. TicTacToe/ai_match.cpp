@@ -0,0 +1,45 @@
+// Plays the alpha-beta AI against itself and against random players and prints
+// the search counters (nodes/sec, transposition table hit rate).
+// usage: ./ai_match [boardSize] [numGames] [timeLimitMs] [tableMB]
+#include <iostream>
+#include <cstdlib>
+#include "batch_runner.hpp"
+#include "ai_search.hpp"
+
+using namespace std;
+
+void printStats(string title, SearchStats stats, TranspositionTable &table){
+	cout << title << endl;
+	cout << "  nodes: " << stats.nodes << "  nodes/sec: " << (long long)stats.nodesPerSecond() << endl;
+	cout << "  tt hit rate: " << stats.ttHitRate()*100 << "%  tt entries: " << table.capacity()
+		<< " (" << table.memoryBytes() / 1024 << " KB)  max depth: " << stats.depthReached << endl;
+}
+
+int main(int argc, char* argv[]){
+	int boardSize = argc > 1 ? atoi(argv[1]) : 3;
+	long long numGames = argc > 2 ? atoll(argv[2]) : 100;
+	int timeLimitMs = argc > 3 ? atoi(argv[3]) : 1000;
+	size_t tableBytes = size_t(argc > 4 ? atoi(argv[4]) : 16) << 20;
+	vector<char> pieces = {'X', 'O'};
+
+	// AI against AI, a perfect game on 3x3 is always a tie
+	AiMoveProvider aiX(pieces, tableBytes, timeLimitMs), aiO(pieces, tableBytes, timeLimitMs);
+	Game selfPlay(vector<Player>{Player("aiX", 'X', &aiX), Player("aiO", 'O', &aiO)}, boardSize);
+	if(selfPlay.startGame() == true){
+		cout << "AI vs AI winner: " << selfPlay.getWinnerName() << endl;
+	}else{
+		cout << "AI vs AI: tie" << endl;
+	}
+	printStats("aiX search", aiX.getSearch().total, aiX.getSearch().getTable());
+
+	// AI against a random player, the AI should never lose
+	AiMoveProvider ai(pieces, tableBytes, timeLimitMs);
+	RandomMoveProvider random(7);
+	Game game(vector<Player>{Player("ai", 'X', &ai), Player("random", 'O', &random)}, boardSize);
+	BatchRunner runner;
+	BatchResult result = runner.run(game, numGames);
+	cout << "AI vs random over " << result.games << " games: ai wins " << result.wins['X']
+		<< ", random wins " << result.wins['O'] << ", ties " << result.ties << endl;
+	printStats("ai search", ai.getSearch().total, ai.getSearch().getTable());
+	return 0;
+}
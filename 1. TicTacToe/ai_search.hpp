@@ -0,0 +1,385 @@
+#ifndef TICTACTOE_AI_SEARCH
+#define TICTACTOE_AI_SEARCH
+#include <vector>
+#include <cstdint>
+#include <cstdlib>
+#include <climits>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "board.hpp"
+#include "move_provider.hpp"
+
+using namespace std;
+
+// Fixed size hash table of already searched positions, keyed by the Zobrist hash of the board.
+// Replacement policy: an entry is overwritten when it holds the same position, when it is
+// left over from an older search, or when the new result was searched at least as deep.
+class TranspositionTable{
+public:
+	enum Bound : uint8_t { EXACT, LOWER, UPPER };
+
+	struct Entry{
+		uint64_t key;
+		int32_t score;
+		int32_t move;		// cell index x*size + y, -1 if none
+		int16_t depth;		// plies left, up to the number of cells of the board
+		uint8_t bound;
+		uint8_t generation;
+	};
+
+private:
+	vector<Entry> entries;
+	uint64_t mask;
+	uint8_t generation;
+
+public:
+	long long probes;
+	long long hits;
+
+	// The table never grows past memoryBytes, it is rounded down to a power of two entries
+	TranspositionTable(size_t memoryBytes = 16 << 20){
+		size_t count = 1;
+		while(count * 2 * sizeof(Entry) <= memoryBytes)	count *= 2;
+		entries.assign(count, Entry{0, 0, -1, -1, EXACT, 0});
+		mask = count - 1;
+		generation = 0;
+		probes = 0;	hits = 0;
+	}
+
+	size_t capacity(){
+		return entries.size();
+	}
+
+	size_t memoryBytes(){
+		return entries.size() * sizeof(Entry);
+	}
+
+	void newSearch(){
+		generation++;
+	}
+
+	void clear(){
+		fill(entries.begin(), entries.end(), Entry{0, 0, -1, -1, EXACT, 0});
+	}
+
+	Entry* probe(uint64_t key){
+		probes++;
+		Entry &entry = entries[key & mask];
+		if(entry.depth >= 0 && entry.key == key){
+			hits++;
+			return &entry;
+		}
+		return NULL;
+	}
+
+	void store(uint64_t key, int depth, int score, Bound bound, int move){
+		Entry &entry = entries[key & mask];
+		bool replace = entry.key == key || entry.generation != generation || depth >= entry.depth;
+		if(!replace)	return;
+		entry.key = key;
+		entry.score = score;
+		entry.move = move;
+		entry.depth = depth;
+		entry.bound = bound;
+		entry.generation = generation;
+	}
+};
+
+class SearchStats{
+public:
+	long long nodes;
+	long long ttProbes;
+	long long ttHits;
+	int depthReached;
+	double seconds;
+
+	SearchStats(){
+		nodes = 0;	ttProbes = 0;	ttHits = 0;
+		depthReached = 0;	seconds = 0;
+	}
+
+	double nodesPerSecond(){
+		return seconds > 0 ? nodes / seconds : 0;
+	}
+
+	double ttHitRate(){
+		return ttProbes > 0 ? double(ttHits) / ttProbes : 0;
+	}
+};
+
+// Alpha-beta minimax with iterative deepening and a transposition table.
+// With more than two players the search is "paranoid": every other player is
+// assumed to play against us, so it stays a two sided search.
+// Small boards are solved exactly, on big boards the search stops at the time
+// limit and the leaves are scored by how many lines are still open for each side.
+class AlphaBetaSearch{
+private:
+	static const int WIN = 1000000;
+	static const int INF = INT_MAX / 2;
+
+	vector<char> pieces;		// turn order
+	int me;						// index in pieces the search plays for
+	int boardSize;
+	TranspositionTable table;
+	vector<uint64_t> cellKeys;	// [cell * numPlayers + player]
+	vector<uint64_t> turnKeys;	// [player to move]
+	vector<int> cellOrder;		// cells sorted from the center outwards
+	Board* board;
+
+	chrono::steady_clock::time_point deadline;
+	bool aborted;
+	long long nodes;
+
+	void prepare(int size){
+		if(size == boardSize)	return;
+		boardSize = size;
+		mt19937_64 rng(0x5EED);
+		cellKeys.resize(size * size * pieces.size());
+		for(uint64_t &key : cellKeys)	key = rng();
+		turnKeys.resize(pieces.size());
+		for(uint64_t &key : turnKeys)	key = rng();
+
+		cellOrder.resize(size * size);
+		for(int c=0; c<size*size; ++c)	cellOrder[c] = c;
+		auto distance = [size](int c){
+			int dx = 2*(c / size) - (size-1), dy = 2*(c % size) - (size-1);
+			return abs(dx) + abs(dy);
+		};
+		stable_sort(cellOrder.begin(), cellOrder.end(), [&](int a, int b){
+			return distance(a) < distance(b);
+		});
+		table.clear();
+	}
+
+	uint64_t hashBoard(int turn){
+		uint64_t key = turnKeys[turn];
+		for(int c=0; c<boardSize*boardSize; ++c){
+			char piece = board->returnPiece(c / boardSize, c % boardSize);
+			if(piece == ' ')	continue;
+			for(int p=0; p<(int)pieces.size(); ++p){
+				if(pieces[p] == piece)	key ^= cellKeys[c * pieces.size() + p];
+			}
+		}
+		return key;
+	}
+
+	bool nearPiece(int x, int y){
+		for(int i=max(0, x-1); i<=min(boardSize-1, x+1); ++i){
+			for(int j=max(0, y-1); j<=min(boardSize-1, y+1); ++j){
+				if(!board->isPossibleXY(i, j))	return true;
+			}
+		}
+		return false;
+	}
+
+	// On boards above 4x4 only cells next to a piece are tried, the rest can not matter at the depths we reach
+	void generateMoves(vector<int> &moves, int firstMove){
+		moves.clear();
+		bool everything = boardSize <= 4 || board->emptyCount() == boardSize*boardSize;
+		if(firstMove >= 0)	moves.push_back(firstMove);
+		for(int c : cellOrder){
+			int x = c / boardSize, y = c % boardSize;
+			if(c == firstMove || !board->isPossibleXY(x, y))	continue;
+			if(everything || nearPiece(x, y))	moves.push_back(c);
+		}
+	}
+
+	// A line counts for a side when the other side has no piece on it, more pieces weigh more
+	int scoreLine(vector<int> &count){
+		int mine = count[me], theirs = 0;
+		for(int p=0; p<(int)pieces.size(); ++p){
+			if(p != me)	theirs += count[p];
+		}
+		if(mine > 0 && theirs == 0)	return mine * mine;
+		if(theirs > 0 && mine == 0)	return -theirs * theirs;
+		return 0;
+	}
+
+	int evaluate(){
+		int score = 0;
+		int numPlayers = pieces.size();
+		vector<int> count(numPlayers);
+		for(int line=0; line<boardSize; ++line){
+			for(int p=0; p<numPlayers; ++p)	count[p] = board->countInRow(pieces[p], line);
+			score += scoreLine(count);
+			for(int p=0; p<numPlayers; ++p)	count[p] = board->countInCol(pieces[p], line);
+			score += scoreLine(count);
+		}
+		for(int p=0; p<numPlayers; ++p)	count[p] = board->countInDiag(pieces[p]);
+		score += scoreLine(count);
+		for(int p=0; p<numPlayers; ++p)	count[p] = board->countInAntiDiag(pieces[p]);
+		score += scoreLine(count);
+		return score;
+	}
+
+	// wins are stored relative to the node so they stay valid at any ply
+	static int toTable(int score, int ply){
+		if(score > WIN/2)	return score + ply;
+		if(score < -WIN/2)	return score - ply;
+		return score;
+	}
+
+	static int fromTable(int score, int ply){
+		if(score > WIN/2)	return score - ply;
+		if(score < -WIN/2)	return score + ply;
+		return score;
+	}
+
+	int alphaBeta(int depth, int ply, int turn, int alpha, int beta, uint64_t key, int &bestMove){
+		bestMove = -1;
+		nodes++;
+		if((nodes & 1023) == 0 && chrono::steady_clock::now() > deadline){
+			aborted = true;
+			return 0;
+		}
+
+		int alphaOrig = alpha, betaOrig = beta;
+		int ttMove = -1;
+		TranspositionTable::Entry* entry = table.probe(key);
+		if(entry != NULL){
+			ttMove = entry->move;
+			if(entry->depth >= depth && ply > 0){
+				int score = fromTable(entry->score, ply);
+				if(entry->bound == TranspositionTable::EXACT)	return score;
+				if(entry->bound == TranspositionTable::LOWER)	alpha = max(alpha, score);
+				if(entry->bound == TranspositionTable::UPPER)	beta = min(beta, score);
+				if(alpha >= beta)	return score;
+			}
+		}
+		if(depth == 0)	return evaluate();
+
+		int numPlayers = pieces.size();
+		int next = (turn + 1) % numPlayers;
+		char piece = pieces[turn];
+		bool maximizing = turn == me;
+
+		vector<int> moves;
+		generateMoves(moves, ttMove);
+
+		int best = maximizing ? -INF : INF;
+		for(int c : moves){
+			int x = c / boardSize, y = c % boardSize;
+			board->insertXY(x, y, piece);
+			int score;
+			if(board->isWinningMove(x, y, piece)){
+				score = maximizing ? WIN - (ply+1) : -(WIN - (ply+1));
+			}else if(board->isFull()){
+				score = 0;
+			}else{
+				uint64_t childKey = key ^ cellKeys[c * numPlayers + turn] ^ turnKeys[turn] ^ turnKeys[next];
+				int childMove;
+				score = alphaBeta(depth-1, ply+1, next, alpha, beta, childKey, childMove);
+			}
+			board->removeXY(x, y, piece);
+			if(aborted)	return 0;
+
+			if(maximizing ? score > best : score < best){
+				best = score;
+				bestMove = c;
+			}
+			if(maximizing)	alpha = max(alpha, best);
+			else	beta = min(beta, best);
+			if(alpha >= beta)	break;
+		}
+
+		TranspositionTable::Bound bound = TranspositionTable::EXACT;
+		if(best <= alphaOrig)	bound = TranspositionTable::UPPER;
+		else if(best >= betaOrig)	bound = TranspositionTable::LOWER;
+		table.store(key, depth, toTable(best, ply), bound, bestMove);
+		return best;
+	}
+
+public:
+	SearchStats stats;		// counters of the last search
+	SearchStats total;		// counters of all searches so far
+	int maxDepth;			// 0 means search until the board is full
+	int timeLimitMs;
+
+	// pieces are the players in turn order
+	AlphaBetaSearch(vector<char> pieces, size_t tableBytes = 16 << 20, int timeLimitMs = 1000)
+		: table(tableBytes){
+		this->pieces = pieces;
+		this->me = 0;
+		this->boardSize = -1;
+		this->board = NULL;
+		this->maxDepth = 0;
+		this->timeLimitMs = timeLimitMs;
+	}
+
+	// Best cell for piece on the board, false when the board is full
+	bool findMove(Board &board, char piece, int &x, int &y){
+		auto start = chrono::steady_clock::now();
+		this->board = &board;
+		prepare(board.getSize());
+		int player = find(pieces.begin(), pieces.end(), piece) - pieces.begin();
+		if(player == (int)pieces.size() || board.isFull())	return false;
+		// scores in the table are from the side of me, they are useless for another player
+		if(player != me)	table.clear();
+		me = player;
+
+		table.newSearch();
+		long long probesBefore = table.probes, hitsBefore = table.hits;
+		deadline = start + chrono::milliseconds(timeLimitMs);
+		nodes = 0;
+		aborted = false;
+		stats = SearchStats();
+
+		uint64_t key = hashBoard(me);
+		int depthLimit = board.emptyCount();
+		if(maxDepth > 0)	depthLimit = min(depthLimit, maxDepth);
+
+		int bestMove = -1;
+		for(int depth=1; depth<=depthLimit; ++depth){
+			int move;
+			int score = alphaBeta(depth, 0, me, -INF, INF, key, move);
+			if(aborted)	break;		// keep the move of the last finished depth
+			bestMove = move;
+			stats.depthReached = depth;
+			if(score > WIN/2 || score < -WIN/2)	break;	// the result is forced
+		}
+		if(bestMove == -1){
+			// not even depth 1 finished, take the first legal move
+			vector<int> moves;
+			generateMoves(moves, -1);
+			bestMove = moves[0];
+		}
+		x = bestMove / boardSize;
+		y = bestMove % boardSize;
+
+		stats.nodes = nodes;
+		stats.ttProbes = table.probes - probesBefore;
+		stats.ttHits = table.hits - hitsBefore;
+		stats.seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+		total.nodes += stats.nodes;
+		total.ttProbes += stats.ttProbes;
+		total.ttHits += stats.ttHits;
+		total.seconds += stats.seconds;
+		total.depthReached = max(total.depthReached, stats.depthReached);
+		return true;
+	}
+
+	TranspositionTable& getTable(){
+		return this->table;
+	}
+};
+
+// MoveProvider backed by the alpha-beta search
+class AiMoveProvider : public MoveProvider{
+private:
+	AlphaBetaSearch search;
+public:
+	AiMoveProvider(vector<char> pieces, size_t tableBytes = 16 << 20, int timeLimitMs = 1000)
+		: search(pieces, tableBytes, timeLimitMs){
+	}
+
+	bool nextMove(Board &board, char piece, int &x, int &y) override{
+		return search.findMove(board, piece, x, y);
+	}
+
+	AlphaBetaSearch& getSearch(){
+		return this->search;
+	}
+};
+
+#endif
@@ -0,0 +1,46 @@
+#ifndef TICTACTOE_BATCH_RUNNER
+#define TICTACTOE_BATCH_RUNNER
+#include <chrono>
+#include "game.hpp"
+
+using namespace std;
+
+class BatchResult{
+public:
+	long long games;
+	long long ties;
+	long long wins[256];	// indexed by the winner's piece
+	double seconds;
+
+	BatchResult(){
+		games = 0;	ties = 0;	seconds = 0;
+		fill(wins, wins+256, 0);
+	}
+
+	double gamesPerSecond(){
+		return seconds > 0 ? games / seconds : 0;
+	}
+};
+
+// Plays the same headless Game again and again, the Board allocation is reused for every game
+class BatchRunner{
+public:
+	BatchResult run(Game &game, long long numGames){
+		BatchResult result;
+		auto start = chrono::steady_clock::now();
+		for(long long i=0; i<numGames; ++i){
+			game.resetGame();
+			if(game.startGame() == true){
+				result.wins[(unsigned char)game.getWinnerPiece()]++;
+			}else{
+				result.ties++;
+			}
+		}
+		auto end = chrono::steady_clock::now();
+		result.games = numGames;
+		result.seconds = chrono::duration<double>(end - start).count();
+		return result;
+	}
+};
+
+#endif
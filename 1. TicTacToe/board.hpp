@@ -0,0 +1,190 @@
+#ifndef TICTACTOE_BOARD
+#define TICTACTOE_BOARD
+#include <iostream>
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+using namespace std;
+
+// Board keeps one bitset per piece instead of a grid of chars.
+//  - size <= 8 : the whole board is packed in a single 64 bit word, bit (x*size + y)
+//  - size >  8 : every row is packed in its own run of 64 bit words
+// Along with the bits, every piece keeps how many cells it owns in each
+// row, column and both diagonals. After insertXY() only the counters touching
+// (x, y) change, so checking the winner and checking if the board is full is O(1).
+class Board{
+private:
+	struct PieceState{
+		char piece;
+		vector<uint64_t> bits;
+		vector<int> rowCount;
+		vector<int> colCount;
+		int diagCount;
+		int antiDiagCount;
+	};
+
+	int size;
+	int wordsPerRow;		// 0 when the whole board fits in one word
+	int filled;
+	vector<uint64_t> occupied;
+	vector<PieceState> pieces;
+	int slotOf[256];		// piece -> index in pieces, -1 if not seen yet
+
+	int wordIndex(int x, int y){
+		return wordsPerRow == 0 ? 0 : x*wordsPerRow + y/64;
+	}
+
+	uint64_t bitMask(int x, int y){
+		return wordsPerRow == 0 ? (uint64_t(1) << (x*size + y)) : (uint64_t(1) << (y%64));
+	}
+
+	int slotForPiece(char piece){
+		int &slot = slotOf[(unsigned char)piece];
+		if(slot == -1){
+			PieceState state;
+			state.piece = piece;
+			state.bits.assign(occupied.size(), 0);
+			state.rowCount.assign(size, 0);
+			state.colCount.assign(size, 0);
+			state.diagCount = 0;
+			state.antiDiagCount = 0;
+			slot = pieces.size();
+			pieces.push_back(state);
+		}
+		return slot;
+	}
+
+public:
+	Board(){
+		this->size = 0;
+		this->wordsPerRow = 0;
+		this->filled = 0;
+		fill(slotOf, slotOf+256, -1);
+	}
+
+	Board(int size){
+		this->size = size;
+		this->wordsPerRow = size <= 8 ? 0 : (size + 63)/64;
+		this->filled = 0;
+		// Creating Board
+		occupied.assign(wordsPerRow == 0 ? 1 : size*wordsPerRow, 0);
+		fill(slotOf, slotOf+256, -1);
+	}
+
+	int getSize(){
+		return this->size;
+	}
+
+	bool isFull(){
+		return filled == size*size;
+	}
+
+	int emptyCount(){
+		return size*size - filled;
+	}
+
+	// Empties the board but keeps every allocation, so one Board can be reused across games
+	void clear(){
+		fill(occupied.begin(), occupied.end(), 0);
+		for(PieceState &state : pieces){
+			fill(state.bits.begin(), state.bits.end(), 0);
+			fill(state.rowCount.begin(), state.rowCount.end(), 0);
+			fill(state.colCount.begin(), state.colCount.end(), 0);
+			state.diagCount = 0;
+			state.antiDiagCount = 0;
+		}
+		filled = 0;
+	}
+
+	bool isPossibleXY(int x, int y){
+		if(x < 0 || x >= size || y < 0 || y >= size){
+			return false;
+		}
+		return (occupied[wordIndex(x, y)] & bitMask(x, y)) == 0;
+	}
+
+	void insertXY(int x, int y, char piece){
+		PieceState &state = pieces[slotForPiece(piece)];
+		int word = wordIndex(x, y);
+		uint64_t mask = bitMask(x, y);
+		occupied[word] |= mask;
+		state.bits[word] |= mask;
+
+		state.rowCount[x]++;
+		state.colCount[y]++;
+		if(x == y)	state.diagCount++;
+		if(x + y == size-1)	state.antiDiagCount++;
+		filled++;
+	}
+
+	// Undo of insertXY(x, y, piece), used by the search to take a move back
+	void removeXY(int x, int y, char piece){
+		PieceState &state = pieces[slotOf[(unsigned char)piece]];
+		int word = wordIndex(x, y);
+		uint64_t mask = bitMask(x, y);
+		occupied[word] &= ~mask;
+		state.bits[word] &= ~mask;
+
+		state.rowCount[x]--;
+		state.colCount[y]--;
+		if(x == y)	state.diagCount--;
+		if(x + y == size-1)	state.antiDiagCount--;
+		filled--;
+	}
+
+	// How many cells of a line the piece owns
+	int countInRow(char piece, int x){
+		int slot = slotOf[(unsigned char)piece];
+		return slot == -1 ? 0 : pieces[slot].rowCount[x];
+	}
+
+	int countInCol(char piece, int y){
+		int slot = slotOf[(unsigned char)piece];
+		return slot == -1 ? 0 : pieces[slot].colCount[y];
+	}
+
+	int countInDiag(char piece){
+		int slot = slotOf[(unsigned char)piece];
+		return slot == -1 ? 0 : pieces[slot].diagCount;
+	}
+
+	int countInAntiDiag(char piece){
+		int slot = slotOf[(unsigned char)piece];
+		return slot == -1 ? 0 : pieces[slot].antiDiagCount;
+	}
+
+	// Only the lines passing through (x, y) can be completed by the move at (x, y)
+	bool isWinningMove(int x, int y, char piece){
+		int slot = slotOf[(unsigned char)piece];
+		if(slot == -1)	return false;
+		PieceState &state = pieces[slot];
+		return state.rowCount[x] == size
+			|| state.colCount[y] == size
+			|| (x == y && state.diagCount == size)
+			|| (x + y == size-1 && state.antiDiagCount == size);
+	}
+
+	char returnPiece(int x, int y){
+		int word = wordIndex(x, y);
+		uint64_t mask = bitMask(x, y);
+		if((occupied[word] & mask) == 0)	return ' ';
+		for(PieceState &state : pieces){
+			if(state.bits[word] & mask)	return state.piece;
+		}
+		return ' ';
+	}
+
+	void printBoard(){
+		cout << "Printing Board" << endl;
+		for(int i=0; i<this->size; ++i){
+			for(int j=0; j<this->size; ++j){
+				cout << "| " << returnPiece(i, j);
+			}
+			cout << " |" << endl;
+		}
+	}
+
+};
+
+#endif
@@ -0,0 +1,137 @@
+// Compares the bitboard Board (board.hpp) against the old vector<vector<char>> board
+// which rescans every row, column and diagonal after each move.
+// g++ -O2 -std=c++17 board_benchmark.cpp -o board_benchmark && ./board_benchmark
+#include <iostream>
+#include <vector>
+#include <chrono>
+#include <random>
+#include <algorithm>
+#include "board.hpp"
+
+using namespace std;
+
+// The board as it was before the bitboard, kept here only to benchmark against
+class VectorBoard{
+private:
+	vector<vector<char>> board;
+	int size;
+public:
+	VectorBoard(int size){
+		this->size = size;
+		board.resize(size, vector<char>(size, ' '));
+	}
+
+	bool isFull(){
+		for(int i=0; i<size; ++i){
+			for(int j=0; j<size; ++j){
+				if(board[i][j] == ' '){
+					return false;
+				}
+			}
+		}
+		return true;
+	}
+
+	void insertXY(int x, int y, char piece){
+		board[x][y] = piece;
+	}
+
+	char returnPiece(int x, int y){
+		return board[x][y];
+	}
+
+	bool isPlayerWinner(char piece){
+		for(int curCol=0; curCol<size; ++curCol){
+			bool tempVisited = true;
+			for(int i=0; i<size && tempVisited; ++i){
+				tempVisited = board[i][curCol] == piece;
+			}
+			if(tempVisited)	return true;
+		}
+		for(int curRow=0; curRow<size; ++curRow){
+			bool tempVisited = true;
+			for(int j=0; j<size && tempVisited; ++j){
+				tempVisited = board[curRow][j] == piece;
+			}
+			if(tempVisited)	return true;
+		}
+		bool diagonal = true, reverseDiagonal = true;
+		for(int i=0; i<size; ++i){
+			diagonal = diagonal && board[i][i] == piece;
+			reverseDiagonal = reverseDiagonal && board[i][size-1-i] == piece;
+		}
+		return diagonal || reverseDiagonal;
+	}
+};
+
+// Plays the moves in order, alternating 'X' and 'O', until somebody wins or the board is full.
+// Returns the number of moves played so both boards can be checked to agree.
+int playVectorBoard(int size, const vector<int> &moves){
+	VectorBoard board(size);
+	char pieces[2] = {'X', 'O'};
+	int played = 0;
+	for(int cell : moves){
+		if(board.isFull())	break;
+		char piece = pieces[played % 2];
+		board.insertXY(cell / size, cell % size, piece);
+		played++;
+		if(board.isPlayerWinner(piece))	break;
+	}
+	return played;
+}
+
+int playBitBoard(int size, const vector<int> &moves){
+	Board board(size);
+	char pieces[2] = {'X', 'O'};
+	int played = 0;
+	for(int cell : moves){
+		if(board.isFull())	break;
+		char piece = pieces[played % 2];
+		int x = cell / size, y = cell % size;
+		board.insertXY(x, y, piece);
+		played++;
+		if(board.isWinningMove(x, y, piece))	break;
+	}
+	return played;
+}
+
+template<typename F>
+double timeGames(F play, int size, const vector<vector<int>> &games, long long &totalMoves){
+	auto start = chrono::steady_clock::now();
+	totalMoves = 0;
+	for(const vector<int> &moves : games){
+		totalMoves += play(size, moves);
+	}
+	auto end = chrono::steady_clock::now();
+	return chrono::duration<double>(end - start).count();
+}
+
+int main(){
+	mt19937 rng(42);
+	int sizes[] = {3, 8, 16, 32, 64};
+
+	cout << "size\tgames\tvector(ms)\tbitboard(ms)\tspeedup" << endl;
+	for(int size : sizes){
+		// keep the total work roughly the same for every size
+		int numGames = max(20, 2000000 / (size*size*size));
+		vector<int> cells(size*size);
+		for(int i=0; i<size*size; ++i)	cells[i] = i;
+
+		vector<vector<int>> games(numGames);
+		for(vector<int> &moves : games){
+			shuffle(cells.begin(), cells.end(), rng);
+			moves = cells;
+		}
+
+		long long vectorMoves, bitMoves;
+		double vectorTime = timeGames(playVectorBoard, size, games, vectorMoves);
+		double bitTime = timeGames(playBitBoard, size, games, bitMoves);
+		if(vectorMoves != bitMoves){
+			cout << "Boards disagree on size " << size << endl;
+			return 1;
+		}
+		cout << size << "\t" << numGames << "\t" << vectorTime*1000 << "\t\t"
+			<< bitTime*1000 << "\t\t" << vectorTime/bitTime << "x" << endl;
+	}
+	return 0;
+}
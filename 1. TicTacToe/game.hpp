@@ -0,0 +1,150 @@
+#ifndef TICTACTOE_GAME
+#define TICTACTOE_GAME
+#include <iostream>
+#include <string>
+#include <vector>
+#include <assert.h>
+#include "player.hpp"
+#include "board.hpp"
+
+using namespace std;
+
+class Game{
+private:
+	// a MoveProvider giving this many impossible moves in a row ends the game without a winner
+	static const int MAX_BAD_MOVES = 16;
+
+	int numPlayers;
+	int boardSize;
+	// Players sit in a fixed table and a turn index walks around it, so a turn
+	// copies no Player. What a turn needs is kept in its own array.
+	vector<Player> players;
+	vector<char> pieces;
+	vector<MoveProvider*> providers;
+	int turn;
+	Board board;
+	bool isWinner;
+	int winnerIndex;
+	bool consoleIO;
+	
+	// Board keeps per line counters, so only the lines through (x, y) are checked
+	bool isPlayerWinner(int x, int y, char piece){
+		return board.isWinningMove(x, y, piece);
+	}
+
+	bool takeMove(int cur, int &x, int &y){
+		MoveProvider* provider = providers[cur];
+		if(provider != NULL){
+			return provider->nextMove(board, pieces[cur], x, y);
+		}
+		cout << "Enter the coordinates player:" << players[cur].getName() << endl;
+		return (bool)(cin >> x >> y);
+	}
+
+	void seatPlayers(){
+		for(Player &player : players){
+			pieces.push_back(player.getPiece());
+			providers.push_back(player.getMoveProvider());
+		}
+		turn = 0;
+	}
+
+public:
+	Game(int numPlayers, int boardSize){
+		this->numPlayers = numPlayers;
+		this->boardSize = boardSize;
+		this->consoleIO = true;
+
+		// Creating players
+		for(int i=0; i<numPlayers; ++i){
+			string name;
+			char symbol;
+			cout << "Please input Player " << i+1 << " name:";
+			cin >> name;
+			cout << "Please input symbol:";
+			cin >> symbol;
+			players.push_back(Player(name, symbol));
+		}
+		seatPlayers();
+
+		// Creating board
+		board = Board(boardSize);
+	}
+
+	// Headless game: nothing is read or printed, every player must have a MoveProvider.
+	// The same Game (and its Board) can be replayed with resetGame().
+	Game(vector<Player> players, int boardSize){
+		this->numPlayers = players.size();
+		this->boardSize = boardSize;
+		this->consoleIO = false;
+		this->players = players;
+		seatPlayers();
+		board = Board(boardSize);
+	}
+
+	void resetGame(){
+		board.clear();
+		turn = 0;
+	}
+
+	bool startGame(){
+		isWinner = true;
+		int badMoves = 0;
+		while(isWinner){
+			if(board.isFull() == true){
+				isWinner = false;	// The game is tie
+				break;
+			}
+
+			// print the board
+			if(consoleIO)	board.printBoard();
+
+			int cur = turn;
+			// Take coordinates from curPlayer
+			int x, y;
+			if(takeMove(cur, x, y) == false){
+				isWinner = false;	// no more moves, nobody wins
+				break;
+			}
+
+			if(board.isPossibleXY(x, y) == false){
+				if(consoleIO)	cout << "Select correct coordinates"<<endl;
+				if(providers[cur] != NULL && ++badMoves == MAX_BAD_MOVES){
+					isWinner = false;	// the provider is stuck, nobody wins
+					break;
+				}
+				continue;	// same player plays again
+			}else{	// Possible to add the coordinates
+				board.insertXY(x, y, pieces[cur]);
+				badMoves = 0;
+				turn = cur + 1 == numPlayers ? 0 : cur + 1;
+
+				bool isCurPlayerWinner = isPlayerWinner(x, y, pieces[cur]);
+				if(isCurPlayerWinner == true){
+					winnerIndex = cur;
+					break;
+				}else{
+					continue;
+				}
+			}
+		}
+
+		return isWinner;
+	}
+
+	string getWinnerName(){
+		assert(isWinner);
+		return players[winnerIndex].getName();
+	}
+
+	char getWinnerPiece(){
+		assert(isWinner);
+		return pieces[winnerIndex];
+	}
+
+	Board& getBoard(){
+		return this->board;
+	}
+};
+
+#endif
@@ -0,0 +1,81 @@
+#ifndef TICTACTOE_MOVE_PROVIDER
+#define TICTACTOE_MOVE_PROVIDER
+#include <vector>
+#include <random>
+#include <utility>
+#include "board.hpp"
+
+using namespace std;
+
+// Decides where a player puts his piece, so a Game can run without cin.
+// A Player without a MoveProvider is asked on the console.
+class MoveProvider{
+public:
+	// false when the provider has no move to give, the game is then stopped without a winner.
+	// An impossible move is asked for again, a few in a row also stop the game.
+	virtual bool nextMove(Board &board, char piece, int &x, int &y) = 0;
+	virtual ~MoveProvider() = default;
+};
+
+// Picks any empty cell uniformly
+class RandomMoveProvider : public MoveProvider{
+private:
+	mt19937_64 rng;
+public:
+	RandomMoveProvider(unsigned long long seed = 5489){
+		rng.seed(seed);
+	}
+
+	void seed(unsigned long long seed){
+		rng.seed(seed);
+	}
+
+	bool nextMove(Board &board, char, int &x, int &y) override{
+		int empty = board.emptyCount();
+		if(empty == 0)	return false;
+		int size = board.getSize();
+		// guessing is cheap while the board is mostly empty
+		if(empty * 4 >= size*size){
+			uniform_int_distribution<int> cell(0, size*size - 1);
+			while(true){
+				int c = cell(rng);
+				x = c / size;	y = c % size;
+				if(board.isPossibleXY(x, y))	return true;
+			}
+		}
+		// otherwise walk to the k-th empty cell
+		int k = uniform_int_distribution<int>(0, empty - 1)(rng);
+		for(x=0; x<size; ++x){
+			for(y=0; y<size; ++y){
+				if(board.isPossibleXY(x, y) && k-- == 0)	return true;
+			}
+		}
+		return false;
+	}
+};
+
+// Replays a fixed list of moves, used to reproduce a game
+class ScriptedMoveProvider : public MoveProvider{
+private:
+	vector<pair<int, int>> moves;
+	int next;
+public:
+	ScriptedMoveProvider(vector<pair<int, int>> moves){
+		this->moves = moves;
+		this->next = 0;
+	}
+
+	void rewind(){
+		next = 0;
+	}
+
+	bool nextMove(Board &, char, int &x, int &y) override{
+		if(next >= (int)moves.size())	return false;
+		x = moves[next].first;
+		y = moves[next].second;
+		next++;
+		return true;
+	}
+};
+
+#endif
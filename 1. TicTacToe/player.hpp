@@ -0,0 +1,33 @@
+#ifndef TICTACTOE_PLAYER
+#define TICTACTOE_PLAYER
+#include <string>
+#include <cstddef>
+#include "move_provider.hpp"
+
+using namespace std;
+
+class Player{
+private:
+	string name;
+	char piece;
+	MoveProvider* moveProvider;		// NULL means the moves are read from the console
+public:	
+	Player(string name, char piece, MoveProvider* moveProvider = NULL){
+		this->name = name;	this->piece = piece;
+		this->moveProvider = moveProvider;
+	}
+	string getName(){
+		return this->name;
+	}
+	char getPiece(){
+		return this->piece;
+	}
+	MoveProvider* getMoveProvider(){
+		return this->moveProvider;
+	}
+	void setMoveProvider(MoveProvider* moveProvider){
+		this->moveProvider = moveProvider;
+	}
+};
+
+#endif
@@ -0,0 +1,42 @@
+// Headless TicTacToe: random players, no console I/O, prints games/sec.
+// usage: ./simulate [numGames] [boardSize] [numPlayers]
+#include <iostream>
+#include <vector>
+#include <string>
+#include <cstdlib>
+#include "batch_runner.hpp"
+
+using namespace std;
+
+int main(int argc, char* argv[]){
+	long long numGames = argc > 1 ? atoll(argv[1]) : 1000000;
+	int boardSize = argc > 2 ? atoi(argv[2]) : 3;
+	int numPlayers = argc > 3 ? atoi(argv[3]) : 2;
+
+	const string symbols = "XOABCDEFGHIJKLMN";
+	if(numPlayers < 1 || numPlayers > (int)symbols.size()){
+		cout << "Invalid number of players" << endl;
+		return 1;
+	}
+
+	vector<RandomMoveProvider> providers;
+	for(int i=0; i<numPlayers; ++i){
+		providers.push_back(RandomMoveProvider(i+1));
+	}
+	vector<Player> seating;
+	for(int i=0; i<numPlayers; ++i){
+		seating.push_back(Player("player" + to_string(i+1), symbols[i], &providers[i]));
+	}
+
+	Game game(seating, boardSize);
+	BatchRunner runner;
+	BatchResult result = runner.run(game, numGames);
+
+	for(int i=0; i<numPlayers; ++i){
+		cout << seating[i].getName() << " (" << seating[i].getPiece() << ") wins: "
+			<< result.wins[(unsigned char)seating[i].getPiece()] << endl;
+	}
+	cout << "ties: " << result.ties << endl;
+	cout << "games/sec: " << (long long)result.gamesPerSecond() << endl;
+	return 0;
+}
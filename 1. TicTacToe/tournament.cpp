@@ -0,0 +1,30 @@
+// Monte Carlo TicTacToe tournament spread over all cores.
+// usage: ./tournament [numGames] [boardSize] [numPlayers] [numThreads]
+#include <iostream>
+#include <cstdlib>
+#include "tournament.hpp"
+
+using namespace std;
+
+int main(int argc, char* argv[]){
+	long long numGames = argc > 1 ? atoll(argv[1]) : 10000000;
+	int boardSize = argc > 2 ? atoi(argv[2]) : 3;
+	int numPlayers = argc > 3 ? atoi(argv[3]) : 2;
+	int numThreads = argc > 4 ? atoi(argv[4]) : 0;
+
+	if(numPlayers < 1 || numPlayers > Tournament::maxPlayers()){
+		cout << "Invalid number of players" << endl;
+		return 1;
+	}
+
+	Tournament tournament(boardSize, numPlayers, numThreads);
+	BatchResult result = tournament.run(numGames);
+
+	for(int i=0; i<numPlayers; ++i){
+		char piece = tournament.pieceOf(i);
+		cout << "player" << i+1 << " (" << piece << ") wins: " << result.wins[(unsigned char)piece] << endl;
+	}
+	cout << "ties: " << result.ties << endl;
+	cout << "games/sec: " << (long long)result.gamesPerSecond() << endl;
+	return 0;
+}
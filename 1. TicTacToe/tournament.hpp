@@ -0,0 +1,147 @@
+#ifndef TICTACTOE_TOURNAMENT
+#define TICTACTOE_TOURNAMENT
+#include <vector>
+#include <deque>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include "batch_runner.hpp"
+
+using namespace std;
+
+// Games are handed out in chunks. Every worker owns a queue of chunks,
+// it takes work from the front of its own queue and when it runs dry it steals
+// from the back of somebody else's queue. A chunk is thousands of games, so the
+// queue lock is taken once per chunk and never inside the game loop.
+class WorkStealingQueue{
+private:
+	mutex lock;
+	deque<long long> chunks;
+public:
+	void push(long long chunk){
+		lock_guard<mutex> guard(lock);
+		chunks.push_back(chunk);
+	}
+
+	bool pop(long long &chunk){
+		lock_guard<mutex> guard(lock);
+		if(chunks.empty())	return false;
+		chunk = chunks.front();
+		chunks.pop_front();
+		return true;
+	}
+
+	bool steal(long long &chunk){
+		lock_guard<mutex> guard(lock);
+		if(chunks.empty())	return false;
+		chunk = chunks.back();
+		chunks.pop_back();
+		return true;
+	}
+};
+
+// Monte Carlo tournament of random players on an N x N board.
+// Every worker has its own Game (so its own Board), its own RNGs and its own
+// tally. Tallies are only merged after all workers are joined.
+class Tournament{
+private:
+	int boardSize;
+	int numPlayers;
+	int numThreads;
+	unsigned long long seed;
+	long long chunkSize;
+
+	struct alignas(64) WorkerState{
+		WorkStealingQueue queue;
+		BatchResult result;
+	};
+
+	static string symbols(){
+		return "XOABCDEFGHIJKLMNPQRSTUVWYZ";
+	}
+
+	void worker(int id, vector<WorkerState> &workers, long long numGames){
+		vector<RandomMoveProvider> providers(numPlayers);
+		vector<Player> seating;
+		for(int i=0; i<numPlayers; ++i){
+			seating.push_back(Player("player" + to_string(i+1), symbols()[i], &providers[i]));
+		}
+		Game game(seating, boardSize);
+		BatchResult &result = workers[id].result;
+
+		long long chunk;
+		while(true){
+			bool found = workers[id].queue.pop(chunk);
+			for(int i=1; !found && i<numThreads; ++i){
+				found = workers[(id + i) % numThreads].queue.steal(chunk);
+			}
+			if(!found)	break;
+
+			// seeding by chunk (not by worker) keeps results the same whoever plays the chunk
+			for(int i=0; i<numPlayers; ++i){
+				providers[i].seed(seed ^ (chunk * numPlayers + i + 1) * 0x9E3779B97F4A7C15ULL);
+			}
+			long long first = chunk * chunkSize;
+			long long last = min(numGames, first + chunkSize);
+			for(long long g=first; g<last; ++g){
+				game.resetGame();
+				if(game.startGame() == true){
+					result.wins[(unsigned char)game.getWinnerPiece()]++;
+				}else{
+					result.ties++;
+				}
+			}
+			result.games += last - first;
+		}
+	}
+
+public:
+	Tournament(int boardSize, int numPlayers, int numThreads = 0, unsigned long long seed = 1){
+		this->boardSize = boardSize;
+		this->numPlayers = numPlayers;
+		this->numThreads = numThreads > 0 ? numThreads : max(1u, thread::hardware_concurrency());
+		this->seed = seed;
+		this->chunkSize = 4096;
+	}
+
+	static int maxPlayers(){
+		return symbols().size();
+	}
+
+	char pieceOf(int player){
+		return symbols()[player];
+	}
+
+	BatchResult run(long long numGames){
+		vector<WorkerState> workers(numThreads);
+		long long numChunks = (numGames + chunkSize - 1) / chunkSize;
+		// deal the chunks round robin, stealing evens out the rest
+		for(long long c=0; c<numChunks; ++c){
+			workers[c % numThreads].queue.push(c);
+		}
+
+		auto start = chrono::steady_clock::now();
+		vector<thread> threads;
+		for(int id=0; id<numThreads; ++id){
+			threads.push_back(thread(&Tournament::worker, this, id, ref(workers), numGames));
+		}
+		for(thread &t : threads){
+			t.join();
+		}
+		auto end = chrono::steady_clock::now();
+
+		BatchResult total;
+		for(WorkerState &state : workers){
+			total.games += state.result.games;
+			total.ties += state.result.ties;
+			for(int p=0; p<256; ++p){
+				total.wins[p] += state.result.wins[p];
+			}
+		}
+		total.seconds = chrono::duration<double>(end - start).count();
+		return total;
+	}
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef SNAKE_AND_LADDER_BOARD
+#define SNAKE_AND_LADDER_BOARD
+#include <iostream>
+#include <vector>
+
+using namespace std;
+
+class Cell{
+public:
+    bool isSnakeOrLadder;
+    int jump;
+    Cell(){
+        this->isSnakeOrLadder = false;
+    }
+};
+
+class Board{
+public:
+    int size;
+    vector<Cell> cells;
+    Board(){}
+
+    Board(int size){
+        this->size = size;
+        cells.resize(size+1);     // no special Cells
+    }
+
+    void addJump(int start, int end){
+        cells[start].isSnakeOrLadder = true;
+        cells[start].jump = end;
+    }
+    bool possibleToAddSnake(int start, int end){
+        return(start>end && start>=1 && start<=size && end>=1 && end<=size);
+    }
+    bool possibleToAddLadder(int start, int end){
+        return(start<end && start>=1 && start<=size && end>=1 && end<=size);
+    }
+
+    void addSnakesAndLadders(){
+        int snakes;
+        cout << "Enter number of snakes:";
+        cin >> snakes;
+        int snakesAdded = 0;
+        do{
+            int start, end;
+            cout << "Enter the start of snake:" << endl;
+            cin >> start;
+            cout << "Enter the end of snake:" << endl;
+            cin >> end;
+            if(!possibleToAddSnake(start, end)){
+                cout << "Invalid start and end for snake entered, Please enter again!!" << endl;
+                continue;
+            }
+            addJump(start, end);
+            snakesAdded+=1;
+
+        }while(snakesAdded <snakes);
+
+        int ladders;
+        cout << "Enter number of ladders:" << endl;
+        cin >> ladders;
+        int laddersAdded = 0;
+        do{
+            int start, end;
+            cout << "Enter the start of ladder:" << endl;
+            cin >> start;
+            cout << "Enter the end of ladder:" << endl;
+            cin >> end;
+            if(!possibleToAddLadder(start, end)){
+                cout << "Invalid start and end for ladder entered, Please enter again!!" << endl;
+                continue;
+            }
+            addJump(start, end);
+            laddersAdded+=1;
+
+        }while(laddersAdded <ladders);
+    }
+
+    void addSnakesAndLaddersOnBoard(){
+        addSnakesAndLadders();
+    }
+
+    int moveToPos(int position){
+        if(!(position>=1 && position<=size)){
+            cout << "Wrong dice entered!" << endl;
+            return -1;
+        }
+        int finalPos = position;
+        if(cells[position].isSnakeOrLadder == true){
+            finalPos = cells[position].jump;
+        }
+        return finalPos;
+    }
+};
+
+#endif
@@ -0,0 +1,263 @@
+#ifndef SNAKE_AND_LADDER_BOARD_LOADER
+#define SNAKE_AND_LADDER_BOARD_LOADER
+#include <vector>
+#include <string>
+#include <chrono>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "compiled_board.hpp"
+
+using namespace std;
+
+// Read only view of a whole file through mmap
+class MappedFile{
+public:
+    const char* data;
+    size_t length;
+
+    MappedFile(){
+        data = NULL;
+        length = 0;
+    }
+
+    bool open(const string &path){
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if(fd < 0)  return false;
+        struct stat info;
+        if(fstat(fd, &info) != 0){
+            ::close(fd);
+            return false;
+        }
+        length = info.st_size;
+        if(length > 0){
+            void* mapped = mmap(NULL, length, PROT_READ, MAP_PRIVATE, fd, 0);
+            if(mapped == MAP_FAILED){
+                ::close(fd);
+                return false;
+            }
+            madvise(mapped, length, MADV_SEQUENTIAL);
+            data = (const char*)mapped;
+        }
+        ::close(fd);
+        return true;
+    }
+
+    ~MappedFile(){
+        if(data != NULL)    munmap((void*)data, length);
+    }
+};
+
+// Loads a whole board from a file straight into a CompiledBoard.
+// Text format: the board size, then one "start end" pair per snake or ladder,
+// '#' starts a comment. Binary format: "SNLB", uint32 version (1), int32 size,
+// uint32 count, then count pairs of int32 start, end (little endian).
+// Every jump is checked while it is read, the same rules as possibleToAddSnake /
+// possibleToAddLadder plus the conflicts the console never caught:
+// two jumps on one start cell, a jump ending where another starts (chained
+// jumps) and a jump leaving the last cell.
+class BoardLoader{
+private:
+    CompiledBoard board;
+    vector<uint8_t> isEnd;
+    string unit;        // "line" or "entry", used in the error messages
+
+    void error(long long where, string message){
+        errorCount++;
+        if((int)errors.size() < maxErrors){
+            errors.push_back(where > 0 ? unit + " " + to_string(where) + ": " + message : message);
+        }
+    }
+
+    bool setSize(long long size, int maxRoll){
+        if(size < 1 || size > (1LL << 30)){
+            error(0, "invalid board size " + to_string(size));
+            return false;
+        }
+        board = CompiledBoard(size, maxRoll);
+        isEnd.assign(size + 1, 0);
+        return true;
+    }
+
+    static string describe(long long start, long long end){
+        return string(start > end ? "snake " : "ladder ") + to_string(start) + " -> " + to_string(end);
+    }
+
+    void addJump(long long start, long long end, long long where){
+        int size = board.size;
+        if(start < 1 || start > size || end < 1 || end > size){
+            error(where, describe(start, end) + " is off the board");
+        }else if(start == end){
+            error(where, "jump from " + to_string(start) + " to itself");
+        }else if(start == size){
+            error(where, describe(start, end) + " leaves the last cell, nobody could win");
+        }else if(board.dest[start] != start){
+            error(where, describe(start, end) + " starts on the same cell as " + describe(start, board.dest[start]));
+        }else if(isEnd[start]){
+            error(where, describe(start, end) + " starts where another jump ends");
+        }else if(board.dest[end] != end){
+            error(where, describe(start, end) + " ends where another jump starts");
+        }else{
+            board.dest[start] = end;
+            isEnd[end] = 1;
+            jumps++;
+            if(start > end) snakes++;
+            else    ladders++;
+        }
+    }
+
+    bool parseBinary(const char* data, size_t length, int maxRoll){
+        unit = "entry";
+        const size_t header = 16;
+        if(length < header){
+            error(0, "binary board is truncated");
+            return false;
+        }
+        uint32_t version, count;
+        int32_t size;
+        memcpy(&version, data + 4, 4);
+        memcpy(&size, data + 8, 4);
+        memcpy(&count, data + 12, 4);
+        if(version != 1){
+            error(0, "unknown binary board version " + to_string(version));
+            return false;
+        }
+        if(length != header + size_t(count) * 8){
+            error(0, "binary board holds " + to_string((length - header) / 8) + " jumps, header says " + to_string(count));
+            return false;
+        }
+        if(!setSize(size, maxRoll))  return false;
+        const char* entry = data + header;
+        for(uint32_t i=0; i<count; ++i, entry+=8){
+            int32_t start, end;
+            memcpy(&start, entry, 4);
+            memcpy(&end, entry + 4, 4);
+            addJump(start, end, i + 1);
+        }
+        return true;
+    }
+
+    bool parseText(const char* data, size_t length, int maxRoll){
+        unit = "line";
+        const char* p = data;
+        const char* last = data + length;
+        long long line = 1;
+        long long numbers[2];
+        int have = 0;
+        bool sized = false;
+        while(p < last){
+            char c = *p;
+            if(c == '\n'){
+                if(have == 1 && sized)    error(line, "jump without an end");
+                have = 0;
+                line++;
+                p++;
+            }else if(c == ' ' || c == '\t' || c == '\r' || c == ','){
+                p++;
+            }else if(c == '#'){
+                while(p < last && *p != '\n')   p++;
+            }else if(c == '-' || (c >= '0' && c <= '9')){
+                bool negative = c == '-';
+                if(negative)    p++;
+                long long value = 0;
+                while(p < last && *p >= '0' && *p <= '9'){
+                    if(value < (1LL << 40))  value = value * 10 + (*p - '0');
+                    p++;
+                }
+                if(negative)    value = -value;
+                if(!sized){
+                    if(!setSize(value, maxRoll)) return false;
+                    sized = true;
+                    continue;
+                }
+                numbers[have++] = value;
+                if(have == 2){
+                    addJump(numbers[0], numbers[1], line);
+                    have = 0;
+                }
+            }else{
+                error(line, string("unexpected character '") + c + "'");
+                have = 0;
+                while(p < last && *p != '\n')   p++;
+            }
+        }
+        if(have == 1)   error(line, "jump without an end");
+        if(!sized){
+            error(0, "board file has no size");
+            return false;
+        }
+        return true;
+    }
+
+public:
+    vector<string> errors;      // the first maxErrors problems found
+    long long errorCount;
+    long long jumps;
+    long long snakes;
+    long long ladders;
+    double seconds;
+    int maxErrors;
+
+    BoardLoader(){
+        errorCount = 0;
+        jumps = 0;  snakes = 0;  ladders = 0;
+        seconds = 0;
+        maxErrors = 20;
+    }
+
+    // true when the file was read and every jump on it is valid
+    bool load(const string &path, int maxRoll){
+        auto start = chrono::steady_clock::now();
+        errors.clear();
+        errorCount = 0;
+        jumps = 0;  snakes = 0;  ladders = 0;
+        bool read;
+        MappedFile file;
+        if(!file.open(path)){
+            error(0, "can not open " + path);
+            read = false;
+        }else if(file.length >= 4 && memcmp(file.data, "SNLB", 4) == 0){
+            read = parseBinary(file.data, file.length, maxRoll);
+        }else{
+            read = parseText(file.data, file.length, maxRoll);
+        }
+        seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        return read && errorCount == 0;
+    }
+
+    CompiledBoard& getBoard(){
+        return this->board;
+    }
+
+    static bool saveBinary(const string &path, int32_t size, vector<pair<int32_t, int32_t>> &jumps){
+        FILE* out = fopen(path.c_str(), "wb");
+        if(out == NULL) return false;
+        uint32_t version = 1, count = jumps.size();
+        fwrite("SNLB", 1, 4, out);
+        fwrite(&version, 4, 1, out);
+        fwrite(&size, 4, 1, out);
+        fwrite(&count, 4, 1, out);
+        for(auto &jump : jumps){
+            fwrite(&jump.first, 4, 1, out);
+            fwrite(&jump.second, 4, 1, out);
+        }
+        return fclose(out) == 0;
+    }
+
+    static bool saveText(const string &path, int32_t size, vector<pair<int32_t, int32_t>> &jumps){
+        FILE* out = fopen(path.c_str(), "w");
+        if(out == NULL) return false;
+        fprintf(out, "# board size, then one start end pair per snake or ladder\n%d\n", size);
+        for(auto &jump : jumps){
+            fprintf(out, "%d %d\n", jump.first, jump.second);
+        }
+        return fclose(out) == 0;
+    }
+};
+
+#endif
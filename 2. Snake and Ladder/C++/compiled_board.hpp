@@ -0,0 +1,58 @@
+#ifndef SNAKE_AND_LADDER_COMPILED_BOARD
+#define SNAKE_AND_LADDER_COMPILED_BOARD
+#include <vector>
+#include <cstdint>
+#include "board.hpp"
+
+using namespace std;
+
+// Flat form of a Board used by the simulators and the solver.
+// dest[i] is where a player landing on i ends up: the jump end for a snake or
+// a ladder and i itself otherwise. The table is padded past the last cell so
+// dest[position + roll] can always be read, overshooting is then picked
+// without a branch in move().
+class CompiledBoard{
+public:
+    int size;
+    vector<int32_t> dest;
+
+    CompiledBoard(){
+        this->size = 0;
+    }
+
+    // A board of the given size with no snakes and ladders yet
+    CompiledBoard(int size, int maxRoll){
+        this->size = size;
+        dest.resize(size + maxRoll + 1);
+        for(int i=0; i<(int)dest.size(); ++i){
+            dest[i] = i;
+        }
+    }
+
+    CompiledBoard(Board &board, int maxRoll) : CompiledBoard(board.size, maxRoll){
+        for(int i=1; i<=size; ++i){
+            if(board.cells[i].isSnakeOrLadder == true){
+                dest[i] = board.cells[i].jump;
+            }
+        }
+    }
+
+    // Makes sure dest[] can be read for rolls up to maxRoll
+    void pad(int maxRoll){
+        int old = dest.size();
+        if(old >= size + maxRoll + 1)   return;
+        dest.resize(size + maxRoll + 1);
+        for(int i=old; i<(int)dest.size(); ++i){
+            dest[i] = i;
+        }
+    }
+
+    // Same rule as Game::startGame, a roll going past the last cell is lost
+    int move(int position, int roll){
+        int next = position + roll;
+        int landed = dest[next];
+        return next > size ? position : landed;
+    }
+};
+
+#endif
@@ -0,0 +1,123 @@
+#ifndef SNAKE_AND_LADDER_DICE
+#define SNAKE_AND_LADDER_DICE
+#include <iostream>
+#include <vector>
+#include <span>
+#include <cstdint>
+#include "xoshiro.hpp"
+
+using namespace std;
+
+// A Dice is rolled on the console unless it is given a seed, then the faces
+// come from its own xoshiro256** stream and nothing is read.
+class Dice{
+public:
+    int dices;
+    int faces;
+    bool seeded;
+    Xoshiro256 rng;
+    Dice(){
+        this->dices = 1;
+        this->faces = 6;
+        this->seeded = false;
+    }
+
+    Dice(int number, int faces = 6){
+        this->dices = number;
+        this->faces = faces;
+        this->seeded = false;
+    }
+
+    // stream picks one of the independent sequences of the seed, use one per thread
+    Dice(int number, int faces, uint64_t seed, int stream = 0) : rng(seed, stream){
+        this->dices = number;
+        this->faces = faces;
+        this->seeded = true;
+    }
+
+    // Hands out the current stream and moves this Dice 2^128 draws ahead,
+    // so every split Dice gets a stream of its own
+    Dice split(){
+        Dice other = *this;
+        other.seeded = true;
+        rng.jump();
+        return other;
+    }
+
+    int minRoll(){
+        return dices;
+    }
+
+    int maxRoll(){
+        return dices * faces;
+    }
+
+    // probability[s] of rolling a total of s, the faces of every dice are equally likely
+    vector<double> rollDistribution(){
+        vector<double> probability(1, 1.0);
+        for(int d=0; d<dices; ++d){
+            vector<double> next(probability.size() + faces, 0.0);
+            for(int s=0; s<(int)probability.size(); ++s){
+                for(int f=1; f<=faces; ++f){
+                    next[s+f] += probability[s] / faces;
+                }
+            }
+            probability = next;
+        }
+        return probability;
+    }
+
+    int throwDice(){
+        int ans = 0;
+        int diceCount = dices;
+        if(seeded){
+            while(diceCount-->0){
+                ans += 1 + rng.below(faces);
+            }
+            return ans;
+        }
+        while(diceCount-->0){
+            int num;
+            cout << "Enter dice number:";
+            cin >> num;
+            ans+= num;
+        }
+        return ans;
+    }
+
+    // One throw (all the dices) per element, for many players or games in one call.
+    // Every 64 bit draw gives two faces, one from each half.
+    void throwMany(span<int> rolls){
+        if(!seeded){
+            for(int &roll : rolls)  roll = throwDice();
+            return;
+        }
+        uint32_t range = faces;
+        uint32_t threshold = -range % range;
+        Xoshiro256 local = rng;     // keeps the state in registers for the loop
+        auto face = [&](uint32_t bits){
+            uint64_t m = uint64_t(bits) * range;
+            // the rare biased pick is thrown away and drawn again
+            return uint32_t(m) < threshold ? local.below(range) : uint32_t(m >> 32);
+        };
+        int total = rolls.size() * dices;
+        int d = 0, sum = dices, filled = 0;
+        for(int i=0; i<total; i+=2){
+            uint64_t bits = local.next();
+            sum += face(uint32_t(bits >> 32));
+            if(++d == dices){
+                rolls[filled++] = sum;
+                sum = dices;    d = 0;
+            }
+            if(i + 1 == total)  break;
+            sum += face(uint32_t(bits));
+            if(++d == dices){
+                rolls[filled++] = sum;
+                sum = dices;    d = 0;
+            }
+        }
+        rng = local;
+    }
+};
+
+#endif
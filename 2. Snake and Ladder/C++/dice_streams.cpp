@@ -0,0 +1,52 @@
+// Seeded Dice: throwDice against throwMany, and one reproducible stream per thread.
+// usage: ./dice_streams [numRolls] [numThreads] [seed]
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdlib>
+#include "dice.hpp"
+
+using namespace std;
+
+int main(int argc, char* argv[]){
+    long long numRolls = argc > 1 ? atoll(argv[1]) : 100000000;
+    int numThreads = argc > 2 ? atoi(argv[2]) : 4;
+    uint64_t seed = argc > 3 ? strtoull(argv[3], NULL, 10) : 42;
+
+    Dice dice(2, 6, seed);
+    long long sum = 0;
+    auto start = chrono::steady_clock::now();
+    for(long long i=0; i<numRolls; ++i){
+        sum += dice.throwDice();
+    }
+    double oneByOne = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "throwDice : " << (long long)(numRolls / oneByOne) << " throws/sec, mean " << double(sum) / numRolls << endl;
+
+    vector<int> rolls(4096);
+    sum = 0;
+    start = chrono::steady_clock::now();
+    for(long long done=0; done<numRolls; done+=rolls.size()){
+        dice.throwMany(rolls);
+        for(int roll : rolls)   sum += roll;
+    }
+    double many = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "throwMany : " << (long long)(numRolls / many) << " throws/sec, mean " << double(sum) / numRolls << endl;
+
+    // the same seed gives every thread the same stream on every run
+    vector<long long> sums(numThreads);
+    vector<thread> threads;
+    for(int id=0; id<numThreads; ++id){
+        threads.push_back(thread([&, id](){
+            Dice mine(2, 6, seed, id);
+            vector<int> batch(1000);
+            mine.throwMany(batch);
+            for(int roll : batch)   sums[id] += roll;
+        }));
+    }
+    for(thread &t : threads)    t.join();
+    for(int id=0; id<numThreads; ++id){
+        cout << "stream " << id << ": sum of 1000 throws = " << sums[id] << endl;
+    }
+    return 0;
+}
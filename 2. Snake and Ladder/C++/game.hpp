@@ -0,0 +1,82 @@
+#ifndef SNAKE_AND_LADDER_GAME
+#define SNAKE_AND_LADDER_GAME
+#include <iostream>
+#include <vector>
+#include <string>
+#include "dice.hpp"
+#include "player.hpp"
+#include "board.hpp"
+
+using namespace std;
+
+class Game{
+public:
+    // Players sit in a fixed table and turn walks around it, a turn copies
+    // no Player. The position of every player is kept in its own array.
+    vector<Player> players;
+    vector<int> positions;
+    int turn;
+    Board board;
+    Dice dice;
+    int numPlayers;
+    int size;
+
+    int winner;
+
+    Game(int numPlayers, int size, int numDices){
+        this->numPlayers = numPlayers;
+        this->size = size;
+        // Creating players
+        for(int i=0; i<numPlayers; ++i){
+            string name;
+            cout << "Enter the name of player " << i+1 <<" :";
+            cin >> name;
+            players.push_back(Player(name));
+        }
+        positions.assign(numPlayers, 0);
+        turn = 0;
+        winner = -1;
+
+        // Creating Board
+        board = Board(size);
+        board.addSnakesAndLaddersOnBoard();
+
+        // Creating Dice
+        dice = Dice(numDices);
+    }
+
+    void startGame(){
+        cout << "Game started" << endl;
+        bool winnerFound = false;
+        while(!winnerFound){
+            int cur = turn;
+            turn = cur + 1 == numPlayers ? 0 : cur + 1;
+
+            cout << "Player currently playing:" << players[cur].name << endl;
+
+            int move = dice.throwDice();
+            int nextPos = positions[cur] + move;
+
+            if(nextPos > size){
+                continue;
+            }
+
+            int finalPosition = board.moveToPos(nextPos);
+            cout << "Next Position to go:" << finalPosition << endl;
+            if(finalPosition == size){
+                cout << "Winner found:" << players[cur].name << endl;
+                winner = cur;
+                winnerFound = true;
+                continue;
+            }
+
+            positions[cur] = finalPosition;
+        }
+    }
+
+    string getWinner(){
+        return players[winner].name;
+    }
+};
+
+#endif
@@ -0,0 +1,58 @@
+// Loads a board file, reports the time and every invalid jump, can solve it afterwards.
+// usage: ./load_board <file> [numDices] [solve]
+//        ./load_board generate <size> <numJumps> <file> [binary]
+#include <iostream>
+#include <random>
+#include <cstdlib>
+#include "board_loader.hpp"
+#include "markov_solver.hpp"
+
+using namespace std;
+
+int generate(int size, int numJumps, string path, bool binary){
+    // random jumps of up to 50 cells that never share or chain cells
+    mt19937 rng(3);
+    uniform_int_distribution<int> cell(2, size - 1), length(-50, 50);
+    vector<char> used(size + 1, 0);
+    vector<pair<int32_t, int32_t>> jumps;
+    for(int tries=0; (int)jumps.size() < numJumps && tries < 20 * numJumps; ++tries){
+        int start = cell(rng), end = start + length(rng);
+        if(end < 1 || end >= size || start == end || used[start] || used[end]) continue;
+        used[start] = used[end] = 1;
+        jumps.push_back(make_pair(start, end));
+    }
+    bool saved = binary ? BoardLoader::saveBinary(path, size, jumps) : BoardLoader::saveText(path, size, jumps);
+    if(!saved){
+        cout << "Could not write " << path << endl;
+        return 1;
+    }
+    cout << "Wrote " << jumps.size() << " jumps to " << path << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]){
+    if(argc >= 5 && string(argv[1]) == "generate"){
+        return generate(atoi(argv[2]), atoi(argv[3]), argv[4], argc > 5 && string(argv[5]) == "binary");
+    }
+    if(argc < 2){
+        cout << "usage: ./load_board <file> [numDices] [solve]" << endl;
+        return 1;
+    }
+    Dice dice(argc > 2 ? atoi(argv[2]) : 1);
+
+    BoardLoader loader;
+    bool valid = loader.load(argv[1], dice.maxRoll());
+    cout << "Loaded " << loader.jumps << " jumps (" << loader.snakes << " snakes, " << loader.ladders
+         << " ladders) in " << loader.seconds * 1000 << " ms" << endl;
+    if(!valid){
+        cout << loader.errorCount << " problems found:" << endl;
+        for(string &error : loader.errors) cout << "  " << error << endl;
+        return 1;
+    }
+
+    if(argc > 3 && string(argv[3]) == "solve"){
+        MarkovSolver solver(loader.getBoard(), dice);
+        cout << "Expected turns for one player: " << solver.expectedTurns() << endl;
+    }
+    return 0;
+}
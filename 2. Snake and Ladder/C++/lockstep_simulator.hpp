@@ -0,0 +1,252 @@
+#ifndef SNAKE_AND_LADDER_LOCKSTEP_SIMULATOR
+#define SNAKE_AND_LADDER_LOCKSTEP_SIMULATOR
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <cstdint>
+#include <algorithm>
+#include <stdexcept>
+#if defined(__AVX512F__) || defined(__AVX2__)
+#include <immintrin.h>
+#endif
+#include "board.hpp"
+#include "dice.hpp"
+#include "compiled_board.hpp"
+
+using namespace std;
+
+class SimulationResult{
+public:
+    long long games;
+    long long capped;               // games where nobody finished within maxTurns
+    vector<long long> lengthCount;  // lengthCount[r] = games that ended on round r
+    vector<long long> wins;         // by seat
+    double seconds;
+
+    SimulationResult(){
+        games = 0;  capped = 0;  seconds = 0;
+    }
+
+    double gamesPerSecond(){
+        return seconds > 0 ? games / seconds : 0;
+    }
+
+    double meanLength(){
+        double total = 0;
+        for(int r=0; r<(int)lengthCount.size(); ++r)    total += double(r) * lengthCount[r];
+        return games > 0 ? total / games : 0;
+    }
+};
+
+// Runs many Snake and Ladder games in lockstep, one player track per SIMD lane.
+// Players never touch each other, so a game of n players is n independent
+// tracks and it ends on the round the fastest track finishes; a lane plays the
+// seats of a game one after the other. Every turn a lane rolls with its own
+// xorshift state, gathers dest[] from the CompiledBoard and keeps the old
+// position on overshoot. A lane that finishes is recorded and restarted at
+// once, so all lanes stay busy. Threads run their share of the games on their
+// own lanes and the results are merged at the end.
+// Built with AVX-512 or AVX2 support when the compiler targets it, plain C++ otherwise.
+// A roll scales a 24 bit sample by the faces in 32 bits, so dices have at most 256 faces.
+class LockstepSimulator{
+public:
+    static const int LANES = 16;
+
+private:
+    struct alignas(64) Lanes{
+        int32_t position[LANES];
+        int32_t turns[LANES];
+        uint32_t rng[LANES];
+    };
+
+    CompiledBoard board;
+    int dices;
+    int faces;
+    int numPlayers;
+    int numThreads;
+    uint64_t seed;
+
+    static uint64_t splitMix(uint64_t &state){
+        uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+    }
+
+    // One turn for all lanes, returns a bit per lane that finished (or hit maxTurns)
+    uint32_t step(Lanes &lanes){
+        const int32_t* dest = board.dest.data();
+        int32_t size = board.size;
+#if defined(__AVX512F__)
+        __m512i p = _mm512_load_si512(lanes.position);
+        __m512i t = _mm512_load_si512(lanes.turns);
+        __m512i x = _mm512_load_si512(lanes.rng);
+        __m512i roll = _mm512_set1_epi32(dices);
+        __m512i f = _mm512_set1_epi32(faces);
+        for(int d=0; d<dices; ++d){
+            x = _mm512_xor_si512(x, _mm512_slli_epi32(x, 13));
+            x = _mm512_xor_si512(x, _mm512_srli_epi32(x, 17));
+            x = _mm512_xor_si512(x, _mm512_slli_epi32(x, 5));
+            roll = _mm512_add_epi32(roll, _mm512_srli_epi32(_mm512_mullo_epi32(_mm512_srli_epi32(x, 8), f), 24));
+        }
+        __m512i next = _mm512_add_epi32(p, roll);
+        __m512i landed = _mm512_i32gather_epi32(next, dest, 4);
+        __mmask16 over = _mm512_cmpgt_epi32_mask(next, _mm512_set1_epi32(size));
+        p = _mm512_mask_blend_epi32(over, landed, p);
+        t = _mm512_add_epi32(t, _mm512_set1_epi32(1));
+        __mmask16 finished = _mm512_cmpeq_epi32_mask(p, _mm512_set1_epi32(size))
+                           | _mm512_cmpge_epi32_mask(t, _mm512_set1_epi32(maxTurns));
+        _mm512_store_si512(lanes.position, p);
+        _mm512_store_si512(lanes.turns, t);
+        _mm512_store_si512(lanes.rng, x);
+        return finished;
+#elif defined(__AVX2__)
+        uint32_t finished = 0;
+        for(int half=0; half<LANES; half+=8){
+            __m256i p = _mm256_load_si256((__m256i*)(lanes.position + half));
+            __m256i t = _mm256_load_si256((__m256i*)(lanes.turns + half));
+            __m256i x = _mm256_load_si256((__m256i*)(lanes.rng + half));
+            __m256i roll = _mm256_set1_epi32(dices);
+            __m256i f = _mm256_set1_epi32(faces);
+            for(int d=0; d<dices; ++d){
+                x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 13));
+                x = _mm256_xor_si256(x, _mm256_srli_epi32(x, 17));
+                x = _mm256_xor_si256(x, _mm256_slli_epi32(x, 5));
+                roll = _mm256_add_epi32(roll, _mm256_srli_epi32(_mm256_mullo_epi32(_mm256_srli_epi32(x, 8), f), 24));
+            }
+            __m256i next = _mm256_add_epi32(p, roll);
+            __m256i landed = _mm256_i32gather_epi32(dest, next, 4);
+            __m256i over = _mm256_cmpgt_epi32(next, _mm256_set1_epi32(size));
+            p = _mm256_blendv_epi8(landed, p, over);
+            t = _mm256_add_epi32(t, _mm256_set1_epi32(1));
+            __m256i done = _mm256_or_si256(_mm256_cmpeq_epi32(p, _mm256_set1_epi32(size)),
+                                           _mm256_cmpgt_epi32(t, _mm256_set1_epi32(maxTurns - 1)));
+            _mm256_store_si256((__m256i*)(lanes.position + half), p);
+            _mm256_store_si256((__m256i*)(lanes.turns + half), t);
+            _mm256_store_si256((__m256i*)(lanes.rng + half), x);
+            finished |= uint32_t(_mm256_movemask_ps(_mm256_castsi256_ps(done))) << half;
+        }
+        return finished;
+#else
+        uint32_t finished = 0;
+        for(int lane=0; lane<LANES; ++lane){
+            uint32_t x = lanes.rng[lane];
+            int32_t roll = dices;
+            for(int d=0; d<dices; ++d){
+                x ^= x << 13;   x ^= x >> 17;   x ^= x << 5;
+                roll += int32_t(((x >> 8) * uint32_t(faces)) >> 24);
+            }
+            lanes.rng[lane] = x;
+            int32_t p = lanes.position[lane];
+            int32_t next = p + roll;
+            int32_t landed = dest[next];
+            p = next > size ? p : landed;
+            lanes.position[lane] = p;
+            lanes.turns[lane]++;
+            finished |= uint32_t(p == size || lanes.turns[lane] >= maxTurns) << lane;
+        }
+        return finished;
+#endif
+    }
+
+    void worker(int id, long long numGames, SimulationResult &result){
+        Lanes lanes;
+        uint64_t state = seed + 0x632BE59BD9B4E019ULL * (id + 1);
+        for(int lane=0; lane<LANES; ++lane){
+            lanes.position[lane] = 0;
+            lanes.turns[lane] = 0;
+            do{
+                lanes.rng[lane] = uint32_t(splitMix(state));
+            }while(lanes.rng[lane] == 0);   // xorshift never leaves 0
+        }
+
+        result.lengthCount.assign(maxTurns + 1, 0);
+        result.wins.assign(numPlayers, 0);
+        // a game is numPlayers tracks in a row of the same lane, the tracks of one lane are independent
+        int32_t best[LANES];
+        int seat[LANES], winner[LANES];
+        fill(seat, seat+LANES, 0);
+        while(result.games < numGames){
+            uint32_t finished = step(lanes);
+            while(finished != 0 && result.games < numGames){
+                int lane = __builtin_ctz(finished);
+                finished &= finished - 1;
+                int32_t turns = lanes.turns[lane];
+                lanes.position[lane] = 0;
+                lanes.turns[lane] = 0;
+                // earlier seats play first, so they win a tie on the same round
+                if(seat[lane] == 0 || turns < best[lane]){
+                    best[lane] = turns;
+                    winner[lane] = seat[lane];
+                }
+                if(++seat[lane] < numPlayers)   continue;
+
+                seat[lane] = 0;
+                if(best[lane] >= maxTurns){
+                    result.capped++;
+                }else{
+                    result.wins[winner[lane]]++;
+                }
+                result.lengthCount[best[lane]]++;
+                result.games++;
+            }
+        }
+    }
+
+public:
+    int maxTurns;
+
+    LockstepSimulator(Board &board, Dice dice, int numPlayers, int numThreads = 0, uint64_t seed = 1)
+        : LockstepSimulator(CompiledBoard(board, dice.maxRoll()), dice, numPlayers, numThreads, seed){
+    }
+
+    LockstepSimulator(CompiledBoard board, Dice dice, int numPlayers, int numThreads = 0, uint64_t seed = 1){
+        if(dice.faces < 1 || dice.faces > 256)  throw invalid_argument("LockstepSimulator: dices have 1 to 256 faces");
+        board.pad(dice.maxRoll());
+        this->board = board;
+        this->dices = dice.dices;
+        this->faces = dice.faces;
+        this->numPlayers = numPlayers;
+        this->numThreads = numThreads > 0 ? numThreads : max(1u, thread::hardware_concurrency());
+        this->seed = seed;
+        this->maxTurns = 100000;
+    }
+
+    static const char* instructionSet(){
+#if defined(__AVX512F__)
+        return "AVX-512";
+#elif defined(__AVX2__)
+        return "AVX2";
+#else
+        return "scalar";
+#endif
+    }
+
+    SimulationResult run(long long numGames){
+        vector<SimulationResult> perThread(numThreads);
+        auto start = chrono::steady_clock::now();
+        vector<thread> threads;
+        for(int id=0; id<numThreads; ++id){
+            long long share = numGames / numThreads + (id < numGames % numThreads ? 1 : 0);
+            threads.push_back(thread(&LockstepSimulator::worker, this, id, share, ref(perThread[id])));
+        }
+        for(thread &t : threads){
+            t.join();
+        }
+        auto end = chrono::steady_clock::now();
+
+        SimulationResult total;
+        total.lengthCount.assign(maxTurns + 1, 0);
+        total.wins.assign(numPlayers, 0);
+        for(SimulationResult &part : perThread){
+            total.games += part.games;
+            total.capped += part.capped;
+            for(int r=0; r<(int)part.lengthCount.size(); ++r)   total.lengthCount[r] += part.lengthCount[r];
+            for(int p=0; p<numPlayers; ++p) total.wins[p] += part.wins[p];
+        }
+        total.seconds = chrono::duration<double>(end - start).count();
+        return total;
+    }
+};
+
+#endif
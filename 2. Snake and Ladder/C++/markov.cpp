@@ -0,0 +1,59 @@
+// Expected length of a Snake and Ladder game computed from the transition matrix, no simulation.
+// usage: ./markov [numDices] [numPlayers] [randomBoardSize]
+// Solves the classic 100 cell board, then a random board (10000 cells by default) with the sparse solver.
+// The turn distribution costs cells * turns, a 100000 cell board takes seconds.
+#include <iostream>
+#include <chrono>
+#include <random>
+#include <cstdlib>
+#include "markov_solver.hpp"
+
+using namespace std;
+
+void report(string title, Board &board, Dice dice, int numPlayers){
+    auto start = chrono::steady_clock::now();
+    MarkovSolver solver(board, dice);
+    double expected = solver.expectedTurns();
+    vector<double> finish = solver.turnDistribution();
+    double rounds = solver.expectedRounds(numPlayers, finish);
+    auto end = chrono::steady_clock::now();
+
+    cout << title << " (" << board.size << " cells, " << dice.dices << " dice)" << endl;
+    cout << "  expected turns for one player: " << expected << endl;
+    cout << "  expected rounds with " << numPlayers << " players: " << rounds << endl;
+    int mostLikely = max_element(finish.begin(), finish.end()) - finish.begin();
+    double median = 0.0;
+    int medianTurn = 0;
+    while(medianTurn+1 < (int)finish.size() && median < 0.5)   median += finish[++medianTurn];
+    cout << "  most likely length: " << mostLikely << " turns, median: " << medianTurn << " turns" << endl;
+    cout << "  solved in " << chrono::duration<double, milli>(end - start).count() << " ms" << endl;
+}
+
+int main(int argc, char* argv[]){
+    int numDices = argc > 1 ? atoi(argv[1]) : 1;
+    int numPlayers = argc > 2 ? atoi(argv[2]) : 2;
+    int size = argc > 3 ? max(atoi(argv[3]), 100) : 10000;
+    Dice dice(numDices);
+
+    // Milton Bradley board
+    Board classic(100);
+    int jumps[][2] = {{1, 38}, {4, 14}, {9, 31}, {21, 42}, {28, 84}, {36, 44}, {51, 67}, {71, 91}, {80, 100},
+                      {16, 6}, {47, 26}, {49, 11}, {56, 53}, {62, 19}, {64, 60}, {87, 24}, {93, 73}, {95, 75}, {98, 78}};
+    for(auto &jump : jumps){
+        classic.addJump(jump[0], jump[1]);
+    }
+    report("classic board", classic, dice, numPlayers);
+
+    // random board, one jump every 20 cells, each jump moves up to 50 cells
+    Board big(size);
+    mt19937 rng(1);
+    uniform_int_distribution<int> cell(2, size - 1), length(-50, 50);
+    for(int i=0; i<size/20; ++i){
+        int start = cell(rng), end = start + length(rng);
+        if(end >= 1 && end < size && start != end && !big.cells[start].isSnakeOrLadder && !big.cells[end].isSnakeOrLadder){
+            big.addJump(start, end);
+        }
+    }
+    report("random board", big, dice, numPlayers);
+    return 0;
+}
@@ -0,0 +1,257 @@
+#ifndef SNAKE_AND_LADDER_MARKOV_SOLVER
+#define SNAKE_AND_LADDER_MARKOV_SOLVER
+#include <vector>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <utility>
+#include "board.hpp"
+#include "dice.hpp"
+#include "compiled_board.hpp"
+
+using namespace std;
+
+// Snake and Ladder without simulating: the position of one player is a Markov
+// chain over the cells 0..size, the last cell is absorbing. From the transition
+// matrix we get the expected number of turns to finish and the probability of
+// finishing on every turn.
+// The matrix is kept sparse (a row has at most maxRoll-minRoll+1 entries).
+// Boards up to denseLimit cells are solved exactly by Gaussian elimination,
+// bigger boards by Gauss-Seidel sweeps over the sparse rows.
+class MarkovSolver{
+private:
+    CompiledBoard board;
+    int size;
+    // row s of the transition matrix is next/probability[rowStart[s] .. rowStart[s+1])
+    vector<int> rowStart;
+    vector<int32_t> next;
+    vector<double> probability;
+    vector<bool> reachable;     // from the start cell
+    vector<bool> canFinish;     // the last cell can be reached from here
+
+    void buildTransitions(Dice &dice){
+        vector<double> rolls = dice.rollDistribution();
+        rowStart.assign(size + 2, 0);
+        vector<pair<int, double>> row;
+        for(int s=0; s<=size; ++s){
+            rowStart[s] = next.size();
+            if(s == size)   continue;       // finished, no way out
+            row.clear();
+            for(int r=dice.minRoll(); r<=dice.maxRoll(); ++r){
+                row.push_back(make_pair(board.move(s, r), rolls[r]));
+            }
+            sort(row.begin(), row.end());
+            for(int i=0; i<(int)row.size(); ++i){
+                if((int)next.size() > rowStart[s] && next.back() == row[i].first){
+                    probability.back() += row[i].second;
+                }else{
+                    next.push_back(row[i].first);
+                    probability.push_back(row[i].second);
+                }
+            }
+        }
+        rowStart[size+1] = next.size();
+    }
+
+    void findReachable(){
+        reachable.assign(size + 1, false);
+        vector<int> stack(1, 0);
+        reachable[0] = true;
+        while(!stack.empty()){
+            int s = stack.back();
+            stack.pop_back();
+            for(int e=rowStart[s]; e<rowStart[s+1]; ++e){
+                if(!reachable[next[e]]){
+                    reachable[next[e]] = true;
+                    stack.push_back(next[e]);
+                }
+            }
+        }
+
+        // walk the edges backwards from the last cell
+        vector<vector<int>> from(size + 1);
+        for(int s=0; s<size; ++s){
+            for(int e=rowStart[s]; e<rowStart[s+1]; ++e){
+                if(next[e] != s)    from[next[e]].push_back(s);
+            }
+        }
+        canFinish.assign(size + 1, false);
+        canFinish[size] = true;
+        stack.assign(1, size);
+        while(!stack.empty()){
+            int s = stack.back();
+            stack.pop_back();
+            for(int prev : from[s]){
+                if(!canFinish[prev]){
+                    canFinish[prev] = true;
+                    stack.push_back(prev);
+                }
+            }
+        }
+    }
+
+    // (I - Q) E = 1 over the reachable cells, solved with partial pivoting
+    vector<double> solveDense(){
+        vector<int> index(size + 1, -1), cells;
+        for(int s=0; s<size; ++s){
+            if(reachable[s]){
+                index[s] = cells.size();
+                cells.push_back(s);
+            }
+        }
+        int n = cells.size();
+        vector<double> a(size_t(n) * (n + 1), 0.0);
+        for(int i=0; i<n; ++i){
+            int s = cells[i];
+            a[size_t(i)*(n+1) + i] += 1.0;
+            a[size_t(i)*(n+1) + n] = 1.0;
+            for(int e=rowStart[s]; e<rowStart[s+1]; ++e){
+                if(next[e] != size)  a[size_t(i)*(n+1) + index[next[e]]] -= probability[e];
+            }
+        }
+        for(int col=0; col<n; ++col){
+            int pivot = col;
+            for(int r=col+1; r<n; ++r){
+                if(fabs(a[size_t(r)*(n+1) + col]) > fabs(a[size_t(pivot)*(n+1) + col]))  pivot = r;
+            }
+            if(pivot != col){
+                for(int c=col; c<=n; ++c)   swap(a[size_t(col)*(n+1) + c], a[size_t(pivot)*(n+1) + c]);
+            }
+            double diag = a[size_t(col)*(n+1) + col];
+            for(int r=0; r<n; ++r){
+                double factor = a[size_t(r)*(n+1) + col];
+                if(r == col || factor == 0.0)   continue;
+                factor /= diag;
+                for(int c=col; c<=n; ++c){
+                    a[size_t(r)*(n+1) + c] -= factor * a[size_t(col)*(n+1) + c];
+                }
+            }
+        }
+        vector<double> expected(size + 1, 0.0);
+        for(int i=0; i<n; ++i){
+            expected[cells[i]] = a[size_t(i)*(n+1) + n] / a[size_t(i)*(n+1) + i];
+        }
+        return expected;
+    }
+
+    // E[s] = (1 + sum over t != s of p(s,t) E[t]) / (1 - p(s,s)), swept from the end of the board
+    vector<double> solveSparse(){
+        vector<double> expected(size + 1, 0.0);
+        for(int iteration=0; iteration<maxIterations; ++iteration){
+            double change = 0.0;
+            for(int s=size-1; s>=0; --s){
+                if(!reachable[s])   continue;
+                double sum = 1.0, stay = 0.0;
+                for(int e=rowStart[s]; e<rowStart[s+1]; ++e){
+                    if(next[e] == s)    stay += probability[e];
+                    else    sum += probability[e] * expected[next[e]];
+                }
+                double value = sum / (1.0 - stay);
+                change = max(change, fabs(value - expected[s]) / max(1.0, value));
+                expected[s] = value;
+            }
+            if(change < tolerance)  break;
+        }
+        return expected;
+    }
+
+public:
+    int denseLimit;
+    int maxIterations;
+    double tolerance;
+    double dropBelow;
+
+    MarkovSolver(Board &board, Dice dice) : MarkovSolver(CompiledBoard(board, dice.maxRoll()), dice){
+    }
+
+    MarkovSolver(CompiledBoard board, Dice dice){
+        board.pad(dice.maxRoll());
+        this->board = board;
+        this->size = board.size;
+        this->denseLimit = 512;
+        this->maxIterations = 100000;
+        this->tolerance = 1e-12;
+        this->dropBelow = 1e-18;
+        buildTransitions(dice);
+        findReachable();
+    }
+
+    // false when some reachable cell can never get to the end (a snake trap)
+    bool isFinishable(){
+        for(int s=0; s<=size; ++s){
+            if(reachable[s] && !canFinish[s])   return false;
+        }
+        return true;
+    }
+
+    // expected[s] = expected number of turns from cell s to the end
+    vector<double> expectedTurnsFrom(){
+        if(!isFinishable()){
+            vector<double> expected(size + 1, numeric_limits<double>::infinity());
+            expected[size] = 0.0;
+            return expected;
+        }
+        return size <= denseLimit ? solveDense() : solveSparse();
+    }
+
+    double expectedTurns(){
+        return expectedTurnsFrom()[0];
+    }
+
+    // finish[t] = probability that one player reaches the end on exactly his t-th turn.
+    // Stops when less than epsilon of the probability is still on the board.
+    // Only the cells holding some probability are walked, cells below dropBelow are let go.
+    vector<double> turnDistribution(int maxTurns = 100000, double epsilon = 1e-9){
+        vector<double> finish(1, 0.0);
+        vector<double> current(size + 1, 0.0), following(size + 1, 0.0);
+        vector<int> active(1, 0), touched;
+        current[0] = 1.0;
+        double remaining = 1.0;
+        for(int t=1; t<=maxTurns && remaining > epsilon; ++t){
+            touched.clear();
+            for(int s : active){
+                double p = current[s];
+                current[s] = 0.0;
+                for(int e=rowStart[s]; e<rowStart[s+1]; ++e){
+                    if(following[next[e]] == 0.0)   touched.push_back(next[e]);
+                    following[next[e]] += p * probability[e];
+                }
+            }
+            finish.push_back(following[size]);
+            remaining -= following[size];
+            following[size] = 0.0;
+
+            active.clear();
+            for(int s : touched){
+                if(s == size)   continue;
+                if(following[s] < dropBelow){
+                    remaining -= following[s];
+                    following[s] = 0.0;
+                }else{
+                    active.push_back(s);
+                }
+            }
+            swap(current, following);
+        }
+        return finish;
+    }
+
+    // Expected rounds until the first of numPlayers players finishes, finish is the turnDistribution().
+    // The players move independently, so P(nobody done after t rounds) = P(one player not done)^numPlayers
+    double expectedRounds(int numPlayers, vector<double> &finish){
+        if(!isFinishable())    return numeric_limits<double>::infinity();
+        double survival = 1.0, rounds = 0.0;
+        for(int t=0; t<(int)finish.size(); ++t){
+            survival -= finish[t];
+            rounds += pow(max(survival, 0.0), numPlayers);
+        }
+        return rounds;
+    }
+
+    double expectedRounds(int numPlayers){
+        vector<double> finish = turnDistribution();
+        return expectedRounds(numPlayers, finish);
+    }
+};
+
+#endif
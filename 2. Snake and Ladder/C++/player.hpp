@@ -0,0 +1,17 @@
+#ifndef SNAKE_AND_LADDER_PLAYER
+#define SNAKE_AND_LADDER_PLAYER
+#include <string>
+
+using namespace std;
+
+class Player{
+public:
+    string name;
+    Player(){}
+
+    Player(string name){
+        this->name = name;
+    }
+};
+
+#endif
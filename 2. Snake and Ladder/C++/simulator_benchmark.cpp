@@ -0,0 +1,134 @@
+// Games/sec of Snake and Ladder on the classic board:
+//  1. Game::startGame as it is, fed from an in-memory stream with cout thrown away
+//  2. the same rules in a plain scalar loop over Board::moveToPos
+//  3. LockstepSimulator (build with -mavx2 or -mavx512f for the SIMD paths)
+// g++ -O2 -std=c++17 -mavx2 -pthread simulator_benchmark.cpp -o simulator_benchmark
+// usage: ./simulator_benchmark [numGames] [numPlayers] [numThreads]
+#include <iostream>
+#include <sstream>
+#include <streambuf>
+#include <random>
+#include <chrono>
+#include <cstdlib>
+#include "game.hpp"
+#include "markov_solver.hpp"
+#include "lockstep_simulator.hpp"
+
+using namespace std;
+
+int jumps[][2] = {{1, 38}, {4, 14}, {9, 31}, {21, 42}, {28, 84}, {36, 44}, {51, 67}, {71, 91}, {80, 100},
+                  {16, 6}, {47, 26}, {49, 11}, {56, 53}, {62, 19}, {64, 60}, {87, 24}, {93, 73}, {95, 75}, {98, 78}};
+const int numSnakes = 10, numLadders = 9;
+
+// Answers the prompts of Game: first the fixed setup text, then an endless stream of dice faces
+class ScriptedInput : public streambuf{
+    string setup;
+    size_t setupRead;
+    mt19937 rng;
+    char roll[2];
+public:
+    ScriptedInput(string setup) : setup(setup), setupRead(0), rng(7){
+    }
+protected:
+    int underflow() override{
+        if(setupRead < setup.size()){
+            char* begin = &setup[0];
+            setg(begin, begin + setupRead, begin + setup.size());
+            setupRead = setup.size();
+            return traits_type::to_int_type(*gptr());
+        }
+        roll[0] = '1' + rng() % 6;
+        roll[1] = '\n';
+        setg(roll, roll, roll + 2);
+        return traits_type::to_int_type(roll[0]);
+    }
+};
+
+class NullOutput : public streambuf{
+protected:
+    int overflow(int c) override{
+        return c;
+    }
+};
+
+double timeStartGame(int numGames, int numPlayers){
+    ostringstream setup;
+    for(int i=0; i<numPlayers; ++i)  setup << "player" << i+1 << "\n";
+    setup << numSnakes << "\n";
+    for(int i=9; i<9+numSnakes; ++i)    setup << jumps[i][0] << "\n" << jumps[i][1] << "\n";
+    setup << numLadders << "\n";
+    for(int i=0; i<numLadders; ++i)     setup << jumps[i][0] << "\n" << jumps[i][1] << "\n";
+
+    NullOutput nullOutput;
+    streambuf* oldOut = cout.rdbuf(&nullOutput);
+    streambuf* oldIn = cin.rdbuf();
+    auto start = chrono::steady_clock::now();
+    for(int g=0; g<numGames; ++g){
+        ScriptedInput input(setup.str());
+        cin.rdbuf(&input);
+        Game game(numPlayers, 100, 1);
+        game.startGame();
+    }
+    auto end = chrono::steady_clock::now();
+    cin.rdbuf(oldIn);
+    cout.rdbuf(oldOut);
+    return chrono::duration<double>(end - start).count();
+}
+
+double timeScalarLoop(Board &board, long long numGames, int numPlayers, double &meanRounds){
+    mt19937 rng(11);
+    uniform_int_distribution<int> face(1, 6);
+    vector<int> positions(numPlayers);
+    long long totalRounds = 0;
+    auto start = chrono::steady_clock::now();
+    for(long long g=0; g<numGames; ++g){
+        fill(positions.begin(), positions.end(), 0);
+        int turn = 0, turnsPlayed = 0;
+        while(true){
+            int cur = turn;
+            turn = cur + 1 == numPlayers ? 0 : cur + 1;
+            turnsPlayed++;
+            int nextPos = positions[cur] + face(rng);
+            if(nextPos > board.size)    continue;
+            int finalPosition = board.moveToPos(nextPos);
+            if(finalPosition == board.size) break;
+            positions[cur] = finalPosition;
+        }
+        totalRounds += (turnsPlayed + numPlayers - 1) / numPlayers;
+    }
+    auto end = chrono::steady_clock::now();
+    meanRounds = double(totalRounds) / numGames;
+    return chrono::duration<double>(end - start).count();
+}
+
+int main(int argc, char* argv[]){
+    long long numGames = argc > 1 ? atoll(argv[1]) : 10000000;
+    int numPlayers = argc > 2 ? atoi(argv[2]) : 2;
+    int numThreads = argc > 3 ? atoi(argv[3]) : 0;
+
+    Board board(100);
+    for(auto &jump : jumps){
+        board.addJump(jump[0], jump[1]);
+    }
+    Dice dice(1);
+    MarkovSolver solver(board, dice);
+    cout << "expected rounds (Markov solver): " << solver.expectedRounds(numPlayers) << endl;
+
+    int startGames = 2000;
+    double startGameTime = timeStartGame(startGames, numPlayers);
+    cout << "Game::startGame      : " << (long long)(startGames / startGameTime) << " games/sec" << endl;
+
+    long long scalarGames = max(1LL, numGames / 10);
+    double meanRounds;
+    double scalarTime = timeScalarLoop(board, scalarGames, numPlayers, meanRounds);
+    cout << "scalar loop          : " << (long long)(scalarGames / scalarTime) << " games/sec, mean rounds "
+         << meanRounds << endl;
+
+    LockstepSimulator simulator(board, dice, numPlayers, numThreads);
+    SimulationResult result = simulator.run(numGames);
+    cout << "lockstep (" << LockstepSimulator::instructionSet() << ")   : " << (long long)result.gamesPerSecond()
+         << " games/sec, mean rounds " << result.meanLength() << endl;
+    cout << "speedup over scalar loop: " << result.gamesPerSecond() / (scalarGames / scalarTime) << "x, over startGame: "
+         << result.gamesPerSecond() / (startGames / startGameTime) << "x" << endl;
+    return 0;
+}
@@ -0,0 +1,74 @@
+#ifndef SNAKE_AND_LADDER_XOSHIRO
+#define SNAKE_AND_LADDER_XOSHIRO
+#include <cstdint>
+
+using namespace std;
+
+// xoshiro256** by Blackman and Vigna. The state is filled from the seed with splitmix64.
+// jump() moves the generator 2^128 draws ahead, so stream k of a seed (k jumps)
+// never overlaps another stream: one stream per thread gives reproducible parallel runs.
+class Xoshiro256{
+private:
+    uint64_t s[4];
+
+    static uint64_t rotl(uint64_t x, int k){
+        return (x << k) | (x >> (64 - k));
+    }
+
+public:
+    Xoshiro256(uint64_t seed = 1, int stream = 0){
+        uint64_t state = seed;
+        for(int i=0; i<4; ++i){
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            s[i] = z ^ (z >> 31);
+        }
+        for(int i=0; i<stream; ++i){
+            jump();
+        }
+    }
+
+    uint64_t next(){
+        uint64_t result = rotl(s[1] * 5, 7) * 9;
+        uint64_t t = s[1] << 17;
+        s[2] ^= s[0];
+        s[3] ^= s[1];
+        s[1] ^= s[2];
+        s[0] ^= s[3];
+        s[2] ^= t;
+        s[3] = rotl(s[3], 45);
+        return result;
+    }
+
+    // uniform in [0, range) without modulo bias (Lemire's multiply and reject)
+    uint32_t below(uint32_t range){
+        uint64_t m = uint64_t(uint32_t(next() >> 32)) * range;
+        uint32_t low = uint32_t(m);
+        if(low < range){
+            uint32_t threshold = -range % range;
+            while(low < threshold){
+                m = uint64_t(uint32_t(next() >> 32)) * range;
+                low = uint32_t(m);
+            }
+        }
+        return uint32_t(m >> 32);
+    }
+
+    void jump(){
+        static const uint64_t JUMP[] = {0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL,
+                                        0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL};
+        uint64_t t[4] = {0, 0, 0, 0};
+        for(uint64_t word : JUMP){
+            for(int b=0; b<64; ++b){
+                if(word & (uint64_t(1) << b)){
+                    for(int i=0; i<4; ++i)  t[i] ^= s[i];
+                }
+                next();
+            }
+        }
+        for(int i=0; i<4; ++i)  s[i] = t[i];
+    }
+};
+
+#endif
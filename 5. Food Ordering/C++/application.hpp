@@ -0,0 +1,81 @@
+#ifndef FOOD_ORDERING_APPLICATION
+#define FOOD_ORDERING_APPLICATION
+#include <iostream>
+#include "resturant_map.hpp"
+#include "resturant_manager.hpp"
+#include "order_manager.hpp"
+#include "state_store.hpp"
+#include "metrics.hpp"
+
+using namespace std;
+
+class Application{
+	ResturantMap resturantMap;
+	ResturantManager resturantManager;
+	OrderManager orderManager;
+	string dataDirectory;		// empty when nothing is kept across restarts
+
+	// A change the event log can not make durable is not acknowledged: the console
+	// stops at once, what was saved before is recovered on the next start.
+	void initiate(){
+		cout << "Application initiating" << endl;
+		bool durable = !dataDirectory.empty();
+		StateStore stateStore(dataDirectory);
+		try{
+			run(stateStore, durable);
+		}catch(const EventLogFailure& failure){
+			cout << "ERROR: " << failure.what() << ", stopping" << endl;
+			stateStore.close();
+		}
+	}
+
+	void run(StateStore& stateStore, bool durable){
+		int recovered = durable ? stateStore.recover() : 0;
+		if(recovered > 0){
+			cout << "Recovered " << recovered << " resturants" << endl;
+		}else{
+			resturantMap.initiate();
+		}
+
+		while(true){
+			int input;
+			cout << "Enter the input:" << endl;
+			if(!(cin >> input)){
+				break;
+			}
+			switch (input){
+			case 1:
+				resturantManager.add_resturant_menu();
+				break;
+			case 2:
+				resturantManager.update_resturant_menu();
+				break;
+			case 3:
+				orderManager.place_orders();
+				break;
+			case 4:
+				orderManager.update_order_status();
+				break;
+			case 5:
+				resturantManager.update_resturant_menu_in_bulk();
+				break;
+			case 6:
+				cout << Metrics::prometheus();
+				break;
+			}
+			if(durable)	stateStore.snapshotIfLarge();
+		}
+		if(durable){
+			stateStore.snapshot();
+			stateStore.close();
+		}
+	}
+
+public:
+	Application(string dataDirectory = ""){
+		this->dataDirectory = dataDirectory;
+		initiate();	// onboarding
+	}
+};
+
+#endif
@@ -0,0 +1,54 @@
+#ifndef FOOD_ORDERING_DISH_INTERNER
+#define FOOD_ORDERING_DISH_INTERNER
+#include <string>
+#include <deque>
+#include <unordered_map>
+#include <mutex>
+#include <shared_mutex>
+
+using namespace std;
+
+// One id per dish name for the whole catalog, ids are 0, 1, 2, ... in the order the
+// names are first seen. Menus, indexes and orders keep the id, the name is looked
+// up only where a dish comes in or goes out as text.
+class DishInterner{
+	inline static unordered_map<string, int> ids;
+	inline static deque<string> names;		// names[id], a deque never moves its strings
+	inline static shared_mutex lock;
+
+public:
+	// id of dishName, a new one when the name was never seen
+	static int intern(const string& dishName){
+		{
+			shared_lock<shared_mutex> readLock(lock);
+			auto it = ids.find(dishName);
+			if(it != ids.end())	return it->second;
+		}
+		unique_lock<shared_mutex> writeLock(lock);
+		auto it = ids.find(dishName);
+		if(it != ids.end())	return it->second;
+		int id = names.size();
+		names.push_back(dishName);
+		ids[dishName] = id;
+		return id;
+	}
+
+	// id of dishName, -1 when no menu ever had it
+	static int find(const string& dishName){
+		shared_lock<shared_mutex> readLock(lock);
+		auto it = ids.find(dishName);
+		return it == ids.end() ? -1 : it->second;
+	}
+
+	static string name(int dishId){
+		shared_lock<shared_mutex> readLock(lock);
+		return dishId >= 0 && dishId < (int)names.size() ? names[dishId] : "";
+	}
+
+	static int size(){
+		shared_lock<shared_mutex> readLock(lock);
+		return names.size();
+	}
+};
+
+#endif
@@ -0,0 +1,443 @@
+#ifndef FOOD_ORDERING_EVENT_LOG
+#define FOOD_ORDERING_EVENT_LOG
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <stdexcept>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "order.hpp"
+#include "geo_index.hpp"
+
+using namespace std;
+
+enum EventType{
+	RESTURANT_ADDED = 1,	// name, rating, max limit, location, dishes
+	MENU_CHANGED,			// name, (dish, price) pairs: added or repriced
+	RATING_CHANGED,			// name, rating
+	LOCATION_CHANGED,		// name, location
+	ORDER_PLACED,			// order, PLACED or PENDING at its resturant
+	ORDER_COMPLETED			// resturant, order id, promoted order id (0 for none), its start
+};
+
+// Bytes of one event, numbers in host byte order and strings with their length first
+class EventRecord{
+	string bytes;
+
+public:
+	EventRecord(EventType type){
+		bytes.push_back(char(type));
+	}
+
+	EventRecord& putInt(long long value){
+		bytes.append((const char*)&value, sizeof(value));
+		return *this;
+	}
+
+	EventRecord& putDouble(double value){
+		bytes.append((const char*)&value, sizeof(value));
+		return *this;
+	}
+
+	EventRecord& putString(const string& value){
+		putInt(value.size());
+		bytes.append(value);
+		return *this;
+	}
+
+	const string& getBytes() const{
+		return this->bytes;
+	}
+};
+
+// Reads the fields of a record or snapshot back in the order they were put.
+// Reading past the end gives zeros and clears ok, so a torn file is seen and not trusted.
+class EventReader{
+	const char* data;
+	size_t size;
+	size_t pos;
+	bool valid;
+
+public:
+	EventReader(const char* data, size_t size){
+		this->data = data;
+		this->size = size;
+		this->pos = 0;
+		this->valid = true;
+	}
+
+	long long getInt(){
+		long long value = 0;
+		if(pos + sizeof(value) > size){
+			valid = false;
+			return 0;
+		}
+		memcpy(&value, data + pos, sizeof(value));
+		pos += sizeof(value);
+		return value;
+	}
+
+	double getDouble(){
+		double value = 0;
+		if(pos + sizeof(value) > size){
+			valid = false;
+			return 0;
+		}
+		memcpy(&value, data + pos, sizeof(value));
+		pos += sizeof(value);
+		return value;
+	}
+
+	string getString(){
+		long long length = getInt();
+		if(length < 0 || pos + length > size){
+			valid = false;
+			return "";
+		}
+		string value(data + pos, length);
+		pos += length;
+		return value;
+	}
+
+	int getType(){
+		if(pos >= size){
+			valid = false;
+			return 0;
+		}
+		return (unsigned char)data[pos++];
+	}
+
+	bool ok(){
+		return this->valid;
+	}
+
+	bool atEnd(){
+		return this->pos == this->size;
+	}
+};
+
+// A whole file mapped read only, empty when it is missing
+class MappedFile{
+	const char* data;
+	size_t size;
+
+public:
+	MappedFile(const string& path){
+		this->data = NULL;
+		this->size = 0;
+		int fd = ::open(path.c_str(), O_RDONLY);
+		if(fd < 0)	return;
+		struct stat info;
+		if(fstat(fd, &info) == 0 && info.st_size > 0){
+			void* mapped = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+			if(mapped != MAP_FAILED){
+				this->data = (const char*)mapped;
+				this->size = info.st_size;
+			}
+		}
+		::close(fd);
+	}
+
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+
+	~MappedFile(){
+		if(data != NULL)	munmap((void*)data, size);
+	}
+
+	const char* getData(){
+		return this->data;
+	}
+
+	size_t getSize(){
+		return this->size;
+	}
+};
+
+// Thrown by EventLog::sync() when changes can not be made durable any more
+class EventLogFailure : public runtime_error{
+public:
+	EventLogFailure(const string& what) : runtime_error(what){}
+};
+
+// Append only log of every change to resturants, menus and orders.
+// A log file is log.<generation> in the directory: a header, then records of
+// [payload length][checksum][payload]. Changes put their record in a buffer while they
+// still hold the lock of what they changed, so the log keeps their order, and call
+// sync() once the lock is given back. sync() is a group commit: the first waiting thread
+// writes the whole buffer with one fsync for everybody who appended meanwhile.
+// Once a write, fsync or new log file fails the log stops, and from then on every
+// sync() throws EventLogFailure: a change is only acknowledged once sync() returned.
+// Everything is a no op while the log is not open, when replaying or in benchmarks.
+class EventLog{
+	static const uint32_t MAGIC = 0x474C4F46;		// "FOLG"
+	static const uint32_t VERSION = 1;
+
+	inline static atomic<bool> enabled{false};
+	inline static mutex lock;
+	inline static condition_variable flushed;
+	inline static string directory;
+	inline static int fd = -1;
+	inline static long long generation = 0;
+	inline static string buffer;				// appended, not written yet
+	inline static long long appended = 0;		// records so far, the last one's lsn
+	inline static atomic<long long> durable{0};	// records on disk
+	inline static bool flushing = false;
+	inline static atomic<bool> failed{false};	// the log stopped, nothing is durable past durable
+	inline static long long fileBytes = 0;
+	inline static thread_local long long lastAppended = 0;
+
+	static bool openFile(){
+		string path = path_of(directory, generation);
+		fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+		if(fd < 0){
+			cout << "WARNING: Cannot open the event log " << path << endl;
+			return false;
+		}
+		struct stat info;
+		fstat(fd, &info);
+		fileBytes = info.st_size;
+		if(fileBytes == 0){
+			uint32_t header[2] = {MAGIC, VERSION};
+			string bytes((const char*)header, sizeof(header));
+			bytes.append((const char*)&generation, sizeof(generation));
+			if(!writeAll(bytes))	return false;
+			fsync(fd);
+			fileBytes = bytes.size();
+		}
+		return true;
+	}
+
+	static bool writeAll(const string& bytes){
+		size_t done = 0;
+		while(done < bytes.size()){
+			ssize_t written = ::write(fd, bytes.data() + done, bytes.size() - done);
+			if(written < 0){
+				cout << "WARNING: Event log write failed, changes are no longer logged" << endl;
+				enabled = false;
+				return false;
+			}
+			done += written;
+		}
+		return true;
+	}
+
+	static bool syncData(){
+		if(fdatasync(fd) != 0){
+			cout << "WARNING: Event log fdatasync failed, changes are no longer logged" << endl;
+			enabled = false;
+			return false;
+		}
+		return true;
+	}
+
+	// Writes and fsyncs the buffer, called with the lock held and nobody else flushing.
+	// The records only count as durable when both succeeded.
+	static void flushLocked(unique_lock<mutex>& held){
+		flushing = true;
+		string batch;
+		batch.swap(buffer);
+		long long upTo = appended;
+		held.unlock();
+		bool written = batch.empty() || (writeAll(batch) && syncData());
+		held.lock();
+		if(written){
+			fileBytes += batch.size();
+			durable = upTo;
+		}else{
+			failed = true;
+		}
+		flushing = false;
+		flushed.notify_all();
+	}
+
+public:
+	static string path_of(const string& directory, long long generation){
+		return directory + "/log." + to_string(generation);
+	}
+
+	// FNV-1a over the bytes
+	static uint32_t checksum(const char* data, size_t size){
+		uint32_t hash = 2166136261u;
+		for(size_t i=0; i<size; ++i){
+			hash = (hash ^ (unsigned char)data[i]) * 16777619u;
+		}
+		return hash;
+	}
+
+	// starts logging to log.<generation> in the directory, appending when it exists
+	static bool open(const string& directory, long long generation){
+		unique_lock<mutex> held(lock);
+		EventLog::directory = directory;
+		EventLog::generation = generation;
+		failed = false;
+		if(!openFile())	return false;
+		enabled = true;
+		return true;
+	}
+
+	// writes what is left and stops logging
+	static void close(){
+		unique_lock<mutex> held(lock);
+		if(fd < 0)	return;
+		flushed.wait(held, []{ return !flushing; });
+		flushLocked(held);
+		enabled = false;
+		::close(fd);
+		fd = -1;
+	}
+
+	static bool isOpen(){
+		return enabled.load(memory_order_relaxed);
+	}
+
+	static long long getGeneration(){
+		lock_guard<mutex> held(lock);
+		return generation;
+	}
+
+	// bytes in the current log file, written or still buffered
+	static long long size(){
+		lock_guard<mutex> held(lock);
+		return fileBytes + buffer.size();
+	}
+
+	// the record as it is stored: [payload length][checksum][payload]
+	static void frame(const EventRecord& record, string& out){
+		const string& payload = record.getBytes();
+		uint32_t header[2] = {(uint32_t)payload.size(), checksum(payload.data(), payload.size())};
+		out.append((const char*)header, sizeof(header));
+		out.append(payload);
+	}
+
+	// Calls visit(EventReader&) for every complete record in the bytes, in order.
+	// Stops at the first torn or corrupt record, a crash can only cut the tail.
+	template<typename Visit>
+	static void forEachRecord(const char* data, size_t size, Visit visit){
+		size_t pos = 0;
+		while(pos + 2 * sizeof(uint32_t) <= size){
+			uint32_t header[2];
+			memcpy(header, data + pos, sizeof(header));
+			pos += sizeof(header);
+			if(header[0] > size - pos || checksum(data + pos, header[0]) != header[1])	return;
+			EventReader reader(data + pos, header[0]);
+			visit(reader);
+			pos += header[0];
+		}
+	}
+
+	static void append(const EventRecord& record){
+		if(!isOpen())	return;
+		lock_guard<mutex> held(lock);
+		frame(record, buffer);
+		lastAppended = ++appended;
+	}
+
+	// Returns once every record this thread appended is on disk. Throws EventLogFailure
+	// when the log failed since it was opened, the caller's change is then not durable.
+	static void sync(){
+		long long target = lastAppended;
+		if(target <= durable.load() && !failed.load())	return;
+		unique_lock<mutex> held(lock);
+		while(durable < target && fd >= 0 && !failed){
+			if(flushing){
+				flushed.wait(held);
+			}else{
+				flushLocked(held);
+			}
+		}
+		if(failed)	throw EventLogFailure("the event log failed, changes are no longer saved");
+	}
+
+	// Makes everything so far durable and goes on in a new, empty log file.
+	// Returns the generation of the new file, the old ones are left for the caller.
+	static long long rotate(){
+		unique_lock<mutex> held(lock);
+		if(fd < 0)	return generation;
+		flushed.wait(held, []{ return !flushing; });
+		flushLocked(held);
+		::close(fd);
+		generation++;
+		if(!openFile()){
+			enabled = false;
+			failed = true;
+		}
+		return generation;
+	}
+
+	// Calls visit(EventReader&) for every complete record of the log file, in order.
+	// False when the file is missing or is not a log of that generation.
+	template<typename Visit>
+	static bool replay(const string& directory, long long generation, Visit visit){
+		MappedFile file(path_of(directory, generation));
+		const char* data = file.getData();
+		size_t size = file.getSize();
+		size_t headerSize = 2 * sizeof(uint32_t) + sizeof(long long);
+		if(size < headerSize)	return false;
+		uint32_t header[2];
+		long long fileGeneration;
+		memcpy(header, data, sizeof(header));
+		memcpy(&fileGeneration, data + sizeof(header), sizeof(fileGeneration));
+		if(header[0] != MAGIC || header[1] != VERSION || fileGeneration != generation)	return false;
+		forEachRecord(data + headerSize, size - headerSize, visit);
+		return true;
+	}
+
+	static void resturantAdded(const string& resName, int rating, int maxLimit, Location location,
+							   const vector<pair<string, int>>& dishes){
+		if(!isOpen())	return;
+		EventRecord record(RESTURANT_ADDED);
+		record.putString(resName).putInt(rating).putInt(maxLimit).putDouble(location.x).putDouble(location.y);
+		record.putInt(dishes.size());
+		for(auto &dish : dishes)	record.putString(dish.first).putInt(dish.second);
+		append(record);
+	}
+
+	static void menuChanged(const string& resName, const vector<pair<string, int>>& dishes){
+		if(!isOpen())	return;
+		EventRecord record(MENU_CHANGED);
+		record.putString(resName).putInt(dishes.size());
+		for(auto &dish : dishes)	record.putString(dish.first).putInt(dish.second);
+		append(record);
+	}
+
+	static void ratingChanged(const string& resName, int rating){
+		if(!isOpen())	return;
+		append(EventRecord(RATING_CHANGED).putString(resName).putInt(rating));
+	}
+
+	static void locationChanged(const string& resName, Location location){
+		if(!isOpen())	return;
+		append(EventRecord(LOCATION_CHANGED).putString(resName).putDouble(location.x).putDouble(location.y));
+	}
+
+	// an order and where it is, the same layout is used by snapshots
+	static void putOrder(EventRecord& record, const Order& order){
+		record.putInt(order.getId()).putString(order.getUserName()).putString(order.getDishName());
+		record.putString(order.getResName()).putInt(order.getStatus());
+		record.putInt(order.getCreatedAt()).putInt(order.getStartedAt());
+	}
+
+	static void orderPlaced(const Order& order){
+		if(!isOpen())	return;
+		EventRecord record(ORDER_PLACED);
+		putOrder(record, order);
+		append(record);
+	}
+
+	static void orderCompleted(const string& resName, long long orderId, const Order& promoted){
+		if(!isOpen())	return;
+		append(EventRecord(ORDER_COMPLETED).putString(resName).putInt(orderId)
+			.putInt(promoted.getId()).putInt(promoted.getStartedAt()));
+	}
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef FOOD_ORDERING_GEO_INDEX
+#define FOOD_ORDERING_GEO_INDEX
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <algorithm>
+#include <utility>
+#include <cmath>
+#include <cstdint>
+
+using namespace std;
+
+// Position on the city map in kilometres, x to the east and y to the north
+struct Location{
+	double x;
+	double y;
+
+	Location(){
+		this->x = 0;
+		this->y = 0;
+	}
+
+	Location(double x, double y){
+		this->x = x;
+		this->y = y;
+	}
+
+	double distanceTo(const Location& other) const{
+		return hypot(this->x - other.x, this->y - other.y);
+	}
+};
+
+// Resturants bucketed into square cells of CELL_SIZE km, a query only looks at the
+// cells that overlap its circle instead of every resturant. Empty cells are not kept.
+// Adding and removing are O(1), also when many resturants share a cell.
+class GeoIndex{
+	static constexpr double CELL_SIZE = 1.0;
+
+	struct Entry{
+		string name;
+		int rating;
+		Location location;
+	};
+	unordered_map<uint64_t, vector<Entry>> cells;
+	unordered_map<string, size_t> positions;	// resturant -> its place in its cell
+
+	static int32_t cellOf(double coordinate){
+		return (int32_t)floor(coordinate / CELL_SIZE);
+	}
+
+	static uint64_t key(int32_t cellX, int32_t cellY){
+		return (uint64_t(uint32_t(cellX)) << 32) | uint32_t(cellY);
+	}
+
+	// best rating first, ties go to the smaller name
+	static bool better(const Entry* a, const Entry* b){
+		return a->rating != b->rating ? a->rating > b->rating : a->name < b->name;
+	}
+
+public:
+	GeoIndex(){}
+
+	void add(string resName, int rating, Location location){
+		vector<Entry>& cell = cells[key(cellOf(location.x), cellOf(location.y))];
+		positions[resName] = cell.size();
+		cell.push_back(Entry{resName, rating, location});
+	}
+
+	// location is where the resturant was added
+	void remove(string resName, Location location){
+		auto it = cells.find(key(cellOf(location.x), cellOf(location.y)));
+		auto position = positions.find(resName);
+		if(it == cells.end() || position == positions.end())	return;
+		vector<Entry>& cell = it->second;
+		size_t i = position->second;
+		positions.erase(position);
+		if(i + 1 != cell.size()){
+			cell[i] = move(cell.back());
+			positions[cell[i].name] = i;
+		}
+		cell.pop_back();
+		if(cell.empty())	cells.erase(it);
+	}
+
+	bool empty(){
+		return cells.empty();
+	}
+
+	// names of the k best rated resturants within radius km of the location, best first
+	vector<string> bestRatedNear(Location location, double radius, int k){
+		vector<const Entry*> best;		// heap, the worst of the k best on top
+		auto visit = [&](const vector<Entry>& cell){
+			for(const Entry &entry : cell){
+				if(entry.location.distanceTo(location) > radius)	continue;
+				if((int)best.size() < k){
+					best.push_back(&entry);
+					push_heap(best.begin(), best.end(), better);
+				}else if(better(&entry, best.front())){
+					pop_heap(best.begin(), best.end(), better);
+					best.back() = &entry;
+					push_heap(best.begin(), best.end(), better);
+				}
+			}
+		};
+		if(k > 0 && radius >= 0){
+			int32_t fromX = cellOf(location.x - radius), toX = cellOf(location.x + radius);
+			int32_t fromY = cellOf(location.y - radius), toY = cellOf(location.y + radius);
+			// a circle wider than the city is cheaper to answer from the kept cells
+			if(double(toX - fromX + 1) * (toY - fromY + 1) > cells.size()){
+				for(auto &cell : cells)	visit(cell.second);
+			}else{
+				for(int32_t cellX=fromX; cellX<=toX; ++cellX){
+					for(int32_t cellY=fromY; cellY<=toY; ++cellY){
+						auto it = cells.find(key(cellX, cellY));
+						if(it != cells.end())	visit(it->second);
+					}
+				}
+			}
+		}
+		sort_heap(best.begin(), best.end(), better);
+		vector<string> names;
+		names.reserve(best.size());
+		for(const Entry* entry : best)	names.push_back(entry->name);
+		return names;
+	}
+};
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef FOOD_ORDERING_MENU
+#define FOOD_ORDERING_MENU
+#include <iostream>
+#include <string>
+#include <vector>
+#include <memory>
+#include <mutex>
+#include <algorithm>
+#include <utility>
+#include <cstdint>
+#include "dish_interner.hpp"
+
+using namespace std;
+
+// Dish id -> price in one open addressing table with linear probing, 8 bytes a slot.
+// A published table is never changed: a change builds a new table and swaps it in,
+// so readers only hold tableLock to copy the pointer and keep the table as long as
+// they need.
+// Changes must come one at a time (Resturant's menuLock). The string overloads turn
+// the name into its id first. Dishes are never removed.
+class Menu{
+public:
+	class Table{
+		struct Slot{
+			int32_t dishId;		// EMPTY when free
+			int32_t price;
+		};
+		static const int32_t EMPTY = -1;
+
+		vector<Slot> slots;
+		int dishCount;
+
+		size_t slotOf(int dishId) const{
+			size_t mask = slots.size() - 1;
+			size_t slot = (uint32_t(dishId) * 0x9E3779B1u) & mask;
+			while(slots[slot].dishId != EMPTY && slots[slot].dishId != dishId){
+				slot = (slot + 1) & mask;
+			}
+			return slot;
+		}
+
+		// keeps the table at most 3/4 full
+		void reserve(int dishes){
+			if(dishes * 4 <= (int)slots.size() * 3)	return;
+			size_t size = slots.empty() ? 8 : slots.size();
+			while(dishes * 4 > (int)size * 3)	size *= 2;
+			vector<Slot> old;
+			old.swap(slots);
+			slots.assign(size, Slot{EMPTY, 0});
+			for(Slot &slot : old){
+				if(slot.dishId != EMPTY)	slots[slotOf(slot.dishId)] = slot;
+			}
+		}
+
+	public:
+		Table(){
+			dishCount = 0;
+		}
+
+		// price of the dish, -1 when it is not on the menu
+		int getPrice(int dishId) const{
+			if(dishId < 0 || slots.empty())	return -1;
+			const Slot& slot = slots[slotOf(dishId)];
+			return slot.dishId == dishId ? slot.price : -1;
+		}
+
+		int size() const{
+			return dishCount;
+		}
+
+		// visit(dishId, price) for every dish
+		template<typename Visit>
+		void forEachDish(Visit visit) const{
+			for(const Slot &slot : slots){
+				if(slot.dishId != EMPTY)	visit(slot.dishId, slot.price);
+			}
+		}
+
+		// adds the dish or changes its price
+		void set(int dishId, int price){
+			reserve(dishCount + 1);
+			Slot& slot = slots[slotOf(dishId)];
+			if(slot.dishId == EMPTY)	dishCount++;
+			slot = Slot{dishId, price};
+		}
+
+		void reserveFor(int dishes){
+			reserve(dishes);
+		}
+	};
+
+private:
+	shared_ptr<const Table> table;
+	mutable mutex tableLock;
+
+	void publish(shared_ptr<Table> next){
+		shared_ptr<const Table> old = move(next);
+		lock_guard<mutex> lock(tableLock);
+		table.swap(old);
+	}
+
+public:
+	Menu(){
+		table = make_shared<const Table>();
+	}
+
+	// a copy shares the current table, tables never change
+	Menu(const Menu& other){
+		table = other.snapshot();
+	}
+
+	Menu& operator=(const Menu& other){
+		shared_ptr<const Table> current = other.snapshot();
+		lock_guard<mutex> lock(tableLock);
+		table.swap(current);
+		return *this;
+	}
+
+	// the current table, stays valid and unchanged for as long as it is held
+	shared_ptr<const Table> snapshot() const{
+		lock_guard<mutex> lock(tableLock);
+		return table;
+	}
+
+	void printMenu(){
+		shared_ptr<const Table> current = snapshot();
+		vector<pair<string, int>> dishes;
+		current->forEachDish([&](int dishId, int price){
+			dishes.push_back(make_pair(DishInterner::name(dishId), price));
+		});
+		sort(dishes.begin(), dishes.end());
+		for(auto &dish : dishes){
+			cout << dish.first << "\t\t:" << dish.second << endl;
+		}
+	}
+
+	// price of the dish, -1 when it is not on the menu
+	int getPrice(int dishId){
+		return snapshot()->getPrice(dishId);
+	}
+
+	int getPrice(string dishName){
+		return getPrice(DishInterner::find(dishName));
+	}
+
+	int size(){
+		return snapshot()->size();
+	}
+
+	// visit(dishId, price) for every dish on the current menu
+	template<typename Visit>
+	void forEachDish(Visit visit){
+		snapshot()->forEachDish(visit);
+	}
+
+	// Prices are never negative, a negative price is read as "not on the menu"
+	static bool validPrice(int price){
+		if(price < 0){
+			cout << "WARNING: Negative price, menu not changed" << endl;
+			return false;
+		}
+		return true;
+	}
+
+	bool updateMenu(int dishId, int price){
+		if(!validPrice(price))	return false;
+		shared_ptr<const Table> current = snapshot();
+		if(current->getPrice(dishId) < 0){
+			cout << "WARNING: Dish not present in the menu, update valid dish" << endl;
+			return false;
+		}
+		// When updaing is possible
+		shared_ptr<Table> next = make_shared<Table>(*current);
+		next->set(dishId, price);
+		publish(next);
+		return true;
+	}
+
+	bool updateMenu(string dishName, int price){
+		return updateMenu(DishInterner::find(dishName), price);
+	}
+
+	bool addToMenu(int dishId, int price){
+		if(!validPrice(price))	return false;
+		shared_ptr<const Table> current = snapshot();
+		if(current->getPrice(dishId) >= 0){
+			cout << "WARNING: Dish already present, please add non existing dish" << endl;
+			return false;
+		}
+		// Adding possible
+		shared_ptr<Table> next = make_shared<Table>(*current);
+		next->set(dishId, price);
+		publish(next);
+		return true;
+	}
+
+	bool addToMenu(string dishName, int price){
+		return addToMenu(DishInterner::intern(dishName), price);
+	}
+
+	// Every (dishId, price) at once in one new table: a dish not on the menu is added,
+	// one on it gets the new price, the last change of a dish wins.
+	// Readers see the whole old menu or the whole new one. The prices must not be negative.
+	void applyChanges(const vector<pair<int, int>>& changes){
+		shared_ptr<Table> next = make_shared<Table>(*snapshot());
+		next->reserveFor(next->size() + changes.size());
+		for(auto &change : changes){
+			next->set(change.first, change.second);
+		}
+		publish(next);
+	}
+};
+
+#endif
@@ -0,0 +1,251 @@
+#ifndef FOOD_ORDERING_METRICS
+#define FOOD_ORDERING_METRICS
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+using namespace std;
+
+enum Counter{
+	ORDERS_PLACED,			// got a slot at once
+	ORDERS_PENDING,			// waiting at a full resturant
+	ORDERS_NOT_PLACED,		// nobody serves the dish
+	ORDERS_COMPLETED,
+	CAPACITY_REJECTIONS,	// the picked resturant was full by the time of the reservation
+	SELECTED_BY_PRICE,		// strategy runs, an order may need more than one
+	SELECTED_BY_RATING,
+	SELECTED_NEARBY,
+	MENU_CHANGES,
+	COUNTERS
+};
+
+enum Stage{
+	PLACE_ORDER,			// OrderManager::place, selection and reservation included
+	SELECT,					// one strategy run on the index
+	RESERVE,				// taking the slot and logging the order
+	COMPLETE_ORDER,
+	MENU_UPDATE,			// menu or rating change with its index updates
+	PLACE_BATCH,			// OrderManager::place_batch, the whole batch
+	STAGES
+};
+
+// Counters and latency histograms, written by every thread into its own block so an
+// event is a few plain adds and no shared cache line. The blocks are summed up when
+// asked, total() / quantile() or prometheus() for a scrape.
+// Histograms are HDR style: exact below 16 ticks, then 16 buckets per power of two, so
+// a value is off by 1/16 at most. Ticks are the TSC on x86 (assumed invariant) and
+// nanoseconds elsewhere, they are turned into seconds only when exported.
+// Without LLD_METRICS (cmake -DLLD_METRICS=OFF) every call is empty and
+// compiles away.
+class Metrics{
+	static const int SUB_BITS = 4;
+	static const int SUB_BUCKETS = 1 << SUB_BITS;
+	static const int BUCKETS = (64 - SUB_BITS + 1) * SUB_BUCKETS;
+
+	struct ThreadBlock{
+		atomic<uint64_t> counters[COUNTERS];
+		atomic<uint64_t> buckets[STAGES][BUCKETS];
+		atomic<uint64_t> sums[STAGES];		// ticks
+	};
+
+	inline static mutex blocksLock;
+	inline static vector<ThreadBlock*> blocks;		// kept after their thread ends
+	inline static thread_local ThreadBlock* mine = NULL;
+
+	static const char* counterName(int counter){
+		static const char* names[COUNTERS] = {"placed", "pending", "not_placed", "completed",
+			"capacity_rejected", "by_price", "by_rating", "nearby", "menu_changes"};
+		return names[counter];
+	}
+
+	static const char* stageName(int stage){
+		static const char* names[STAGES] = {"place_order", "select", "reserve", "complete_order", "menu_update",
+			"place_batch"};
+		return names[stage];
+	}
+
+	static long long steadyNs(){
+		return chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+	}
+
+	static ThreadBlock& block(){
+		if(mine == NULL){
+			mine = new ThreadBlock();
+			lock_guard<mutex> lock(blocksLock);
+			blocks.push_back(mine);
+		}
+		return *mine;
+	}
+
+	// only the owning thread writes its block, a relaxed load and store is enough
+	static void add(atomic<uint64_t>& value, uint64_t n){
+		value.store(value.load(memory_order_relaxed) + n, memory_order_relaxed);
+	}
+
+	static int bucketOf(uint64_t value){
+		if(value < (uint64_t)SUB_BUCKETS)	return value;
+		int exponent = 63 - __builtin_clzll(value);
+		return (exponent - SUB_BITS + 1) * SUB_BUCKETS + ((value >> (exponent - SUB_BITS)) & (SUB_BUCKETS - 1));
+	}
+
+	// smallest value of the bucket, the next bucket's for its end
+	static double lowerBound(int bucket){
+		if(bucket < SUB_BUCKETS)	return bucket;
+		int exponent = bucket / SUB_BUCKETS + SUB_BITS - 1;
+		return double(SUB_BUCKETS + bucket % SUB_BUCKETS) * double(1ull << (exponent - SUB_BITS));
+	}
+
+	static double secondsPerTick(){
+#if defined(__x86_64__) || defined(__i386__)
+		long long elapsedNs = steadyNs() - startNs;
+		while(elapsedNs < 1000000)	elapsedNs = steadyNs() - startNs;
+		return elapsedNs * 1e-9 / double(ticks() - startTicks);
+#else
+		return 1e-9;
+#endif
+	}
+
+	// the histogram of a stage summed over every thread
+	static vector<uint64_t> merged(Stage stage, uint64_t& sum){
+		vector<uint64_t> buckets(BUCKETS, 0);
+		sum = 0;
+		lock_guard<mutex> lock(blocksLock);
+		for(ThreadBlock* from : blocks){
+			for(int i=0; i<BUCKETS; ++i)	buckets[i] += from->buckets[stage][i].load(memory_order_relaxed);
+			sum += from->sums[stage].load(memory_order_relaxed);
+		}
+		return buckets;
+	}
+
+public:
+	static bool enabled(){
+#ifdef LLD_METRICS
+		return true;
+#else
+		return false;
+#endif
+	}
+
+	static uint64_t ticks(){
+#if defined(__x86_64__) || defined(__i386__)
+		return __rdtsc();
+#else
+		return steadyNs();
+#endif
+	}
+
+	static void count(Counter counter, uint64_t n = 1){
+#ifdef LLD_METRICS
+		add(block().counters[counter], n);
+#endif
+	}
+
+	// one event of the stage that started at startTicks
+	static void record(Stage stage, uint64_t startTicks){
+#ifdef LLD_METRICS
+		uint64_t elapsed = ticks() - startTicks;
+		ThreadBlock& to = block();
+		add(to.buckets[stage][bucketOf(elapsed)], 1);
+		add(to.sums[stage], elapsed);
+#endif
+	}
+
+	static uint64_t total(Counter counter){
+		uint64_t sum = 0;
+		lock_guard<mutex> lock(blocksLock);
+		for(ThreadBlock* from : blocks)	sum += from->counters[counter].load(memory_order_relaxed);
+		return sum;
+	}
+
+	// latency of the stage in seconds below which a fraction q of the events fall, 0 without events
+	static double quantile(Stage stage, double q){
+		uint64_t sum;
+		vector<uint64_t> buckets = merged(stage, sum);
+		uint64_t events = 0;
+		for(uint64_t n : buckets)	events += n;
+		if(events == 0)	return 0;
+		uint64_t rank = (uint64_t)(q * (events - 1)), seen = 0;
+		for(int i=0; i<BUCKETS; ++i){
+			seen += buckets[i];
+			if(seen > rank)	return (lowerBound(i) + lowerBound(i + 1)) / 2 * secondsPerTick();
+		}
+		return 0;
+	}
+
+	// every counter and histogram in the Prometheus text format, the histogram
+	// buckets are the powers of two from 64ns to 17s
+	static string prometheus(){
+		string text;
+		char line[256];
+		text += "# HELP food_ordering_events_total Orders and changes by outcome\n";
+		text += "# TYPE food_ordering_events_total counter\n";
+		for(int counter=0; counter<COUNTERS; ++counter){
+			snprintf(line, sizeof(line), "food_ordering_events_total{event=\"%s\"} %llu\n",
+					 counterName(counter), (unsigned long long)total((Counter)counter));
+			text += line;
+		}
+		double toSeconds = secondsPerTick();
+		text += "# HELP food_ordering_stage_seconds Latency of the ordering stages\n";
+		text += "# TYPE food_ordering_stage_seconds histogram\n";
+		for(int stage=0; stage<STAGES; ++stage){
+			uint64_t sum;
+			vector<uint64_t> buckets = merged((Stage)stage, sum);
+			uint64_t cumulative = 0;
+			int bucket = 0;
+			for(int power=6; power<=34; ++power){
+				double bound = double(1ull << power) * 1e-9;
+				while(bucket < BUCKETS && lowerBound(bucket + 1) * toSeconds <= bound){
+					cumulative += buckets[bucket++];
+				}
+				snprintf(line, sizeof(line), "food_ordering_stage_seconds_bucket{stage=\"%s\",le=\"%g\"} %llu\n",
+						 stageName(stage), bound, (unsigned long long)cumulative);
+				text += line;
+			}
+			while(bucket < BUCKETS)	cumulative += buckets[bucket++];
+			snprintf(line, sizeof(line), "food_ordering_stage_seconds_bucket{stage=\"%s\",le=\"+Inf\"} %llu\n"
+					 "food_ordering_stage_seconds_sum{stage=\"%s\"} %.9f\n"
+					 "food_ordering_stage_seconds_count{stage=\"%s\"} %llu\n",
+					 stageName(stage), (unsigned long long)cumulative,
+					 stageName(stage), sum * toSeconds,
+					 stageName(stage), (unsigned long long)cumulative);
+			text += line;
+		}
+		return text;
+	}
+
+private:
+	// the clock pair secondsPerTick() measures from
+	inline static const uint64_t startTicks = ticks();
+	inline static const long long startNs = steadyNs();
+};
+
+// Records the time from its construction to its end into a stage
+class StageTimer{
+#ifdef LLD_METRICS
+	Stage stage;
+	uint64_t start;
+#endif
+
+public:
+	StageTimer(Stage stage){
+#ifdef LLD_METRICS
+		this->stage = stage;
+		this->start = Metrics::ticks();
+#endif
+	}
+
+	~StageTimer(){
+#ifdef LLD_METRICS
+		Metrics::record(stage, start);
+#endif
+	}
+};
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef FOOD_ORDERING_ORDER
+#define FOOD_ORDERING_ORDER
+#include <string>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include "dish_interner.hpp"
+
+using namespace std;
+
+enum OrderStatus{
+	NOT_PLACED,		// no resturant serves the dish
+	PLACED,			// being prepared, holds one unit of the resturant capacity
+	PENDING,		// waiting for the resturant to free up
+	COMPLETED
+};
+
+// A plain record without heap memory, so it can live in the OrderPool and be copied
+// out as a snapshot. The dish is kept as its id, the resturant name is borrowed from
+// the resturant and the user name is cut to USER_NAME_LENGTH characters.
+class Order{
+public:
+	static const uint32_t NO_HANDLE = 0xFFFFFFFF;
+	static const int USER_NAME_LENGTH = 31;
+
+private:
+	long long id;
+	int dishId;				// -1 when no menu has the dish
+	OrderStatus status;
+	const string* resName;	// name of the resturant holding the order
+	long long createdAt;	// wall clock, nanoseconds since the epoch, so logged times survive a restart
+	long long startedAt;	// when it got a slot
+	uint32_t handle;		// slot in the OrderPool while a resturant holds it
+	uint32_t prev;			// neighbours in the OrderList of the resturant
+	uint32_t next;
+	char userName[USER_NAME_LENGTH + 1];
+
+	friend class OrderList;
+
+public:
+	static long long now(){
+		return chrono::duration_cast<chrono::nanoseconds>(chrono::system_clock::now().time_since_epoch()).count();
+	}
+
+	Order(){
+		this->id = 0;
+		this->dishId = -1;
+		this->status = NOT_PLACED;
+		this->resName = NULL;
+		this->createdAt = 0;
+		this->startedAt = 0;
+		this->handle = NO_HANDLE;
+		this->prev = NO_HANDLE;
+		this->next = NO_HANDLE;
+		this->userName[0] = '\0';
+	}
+
+	Order(long long id, const string& userName, int dishId) : Order(){
+		this->id = id;
+		this->dishId = dishId;
+		this->createdAt = now();
+		size_t length = min(userName.size(), (size_t)USER_NAME_LENGTH);
+		memcpy(this->userName, userName.data(), length);
+		this->userName[length] = '\0';
+	}
+
+	long long getId() const{
+		return this->id;
+	}
+
+	string getUserName() const{
+		return string(this->userName);
+	}
+
+	int getDishId() const{
+		return this->dishId;
+	}
+
+	string getDishName() const{
+		return DishInterner::name(this->dishId);
+	}
+
+	const string& getResName() const{
+		static const string none;
+		return this->resName == NULL ? none : *this->resName;
+	}
+
+	bool isHeldBy(const string* resName) const{
+		return this->resName == resName;
+	}
+
+	OrderStatus getStatus() const{
+		return this->status;
+	}
+
+	long long getCreatedAt() const{
+		return this->createdAt;
+	}
+
+	long long getStartedAt() const{
+		return this->startedAt;
+	}
+
+	uint32_t getHandle() const{
+		return this->handle;
+	}
+
+	void setResName(const string* resName){
+		this->resName = resName;
+	}
+
+	void setStatus(OrderStatus status){
+		this->status = status;
+		if(status == PLACED)	this->startedAt = now();
+	}
+
+	// for an order read back from the event log or a snapshot
+	void setTimes(long long createdAt, long long startedAt){
+		this->createdAt = createdAt;
+		this->startedAt = startedAt;
+	}
+
+	void setHandle(uint32_t handle){
+		this->handle = handle;
+	}
+};
+
+#endif
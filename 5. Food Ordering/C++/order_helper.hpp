@@ -0,0 +1,69 @@
+#ifndef FOOD_ORDERING_ORDER_HELPER
+#define FOOD_ORDERING_ORDER_HELPER
+#include <string>
+#include <vector>
+#include "resturant_index.hpp"
+#include "metrics.hpp"
+
+using namespace std;
+
+class OrderHelper{
+public:
+    // return the name of the resturant to be selected for placing the order
+    virtual string select_resturant_by_strategy(ResturantIndex& index, int dishId) = 0;
+
+    // the first count resturants in the order of the strategy, for placing many orders at once
+    virtual vector<string> rank_resturants_by_strategy(ResturantIndex& index, int dishId, int count) = 0;
+
+    virtual ~OrderHelper() = default;
+};
+
+class OrderByRating:public OrderHelper{
+public:
+    string select_resturant_by_strategy(ResturantIndex& index, int dishId) override{
+        Metrics::count(SELECTED_BY_RATING);
+        return index.bestRated(dishId);
+    }
+
+    vector<string> rank_resturants_by_strategy(ResturantIndex& index, int dishId, int count) override{
+        Metrics::count(SELECTED_BY_RATING);
+        return index.bestRated(dishId, count);
+    }
+};
+
+class OrderByPrice:public OrderHelper{
+public:
+    string select_resturant_by_strategy(ResturantIndex& index, int dishId) override{
+        Metrics::count(SELECTED_BY_PRICE);
+        return index.cheapest(dishId);
+    }
+
+    vector<string> rank_resturants_by_strategy(ResturantIndex& index, int dishId, int count) override{
+        Metrics::count(SELECTED_BY_PRICE);
+        return index.cheapest(dishId, count);
+    }
+};
+
+// best rated resturant within radius km of the customer
+class OrderNearby:public OrderHelper{
+    Location location;
+    double radius;
+public:
+    OrderNearby(Location location, double radius){
+        this->location = location;
+        this->radius = radius;
+    }
+
+    string select_resturant_by_strategy(ResturantIndex& index, int dishId) override{
+        Metrics::count(SELECTED_NEARBY);
+        vector<string> nearest = index.bestRatedNear(dishId, location, radius, 1);
+        return nearest.empty() ? "" : nearest[0];
+    }
+
+    vector<string> rank_resturants_by_strategy(ResturantIndex& index, int dishId, int count) override{
+        Metrics::count(SELECTED_NEARBY);
+        return index.bestRatedNear(dishId, location, radius, count);
+    }
+};
+
+#endif
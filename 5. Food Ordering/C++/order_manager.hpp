@@ -0,0 +1,276 @@
+#ifndef FOOD_ORDERING_ORDER_MANAGER
+#define FOOD_ORDERING_ORDER_MANAGER
+#include <iostream>
+#include <string>
+#include <atomic>
+#include <vector>
+#include <map>
+#include <utility>
+#include "resturant_map.hpp"
+#include "order_helper.hpp"
+#include "order.hpp"
+#include "event_log.hpp"
+#include "metrics.hpp"
+
+using namespace std;
+
+struct OrderRequest{
+	string userName;
+	string dishName;
+	string selection;		// LOWEST / RATING
+};
+
+class OrderManager{
+	ResturantMap resturantMap;
+	OrderByRating orderByRating;
+	OrderByPrice orderByPrice;
+	inline static atomic<long long> nextOrderId{1};
+	static constexpr size_t RANK_STEP = 16;		// resturants a batch group reads per ranking
+
+    OrderRequest read_order(){
+        OrderRequest request;
+        cout << "User name:" << endl;
+        cin >> request.userName;
+        cout << "dish name:" << endl;
+        cin >> request.dishName;
+        cout << "Selection (LOWEST / RATING):" << endl;
+        cin >> request.selection;
+        return request;
+    }
+
+    void print_order(const Order& order){
+        if(order.getStatus() == NOT_PLACED){
+            cout << "WARNING: No resturant found for the order" << endl;
+            return;
+        }
+        cout << (order.getStatus() == PENDING ? "Order pending at:" : "Order placed at:") << order.getResName()
+             << ", order id:" << order.getId() << endl;
+    }
+
+public:
+	OrderManager(){}
+
+	// the strategy for "LOWEST" or "RATING", NULL for anything else
+	OrderHelper* select_helper(string selection){
+		if(selection == "LOWEST"){
+			return &orderByPrice;
+		}else if(selection == "RATING"){
+			return &orderByRating;
+		}
+		return NULL;
+	}
+
+	// orders after a restart go on from the highest id seen before it
+	static void resume_order_ids(long long nextId){
+		long long cur = nextOrderId.load();
+		while(cur < nextId && !nextOrderId.compare_exchange_weak(cur, nextId)){}
+	}
+
+	static long long next_order_id(){
+		return nextOrderId.load();
+	}
+
+	Order new_order(string userName, string dishName){
+		return Order(nextOrderId++, userName, DishInterner::find(dishName));
+	}
+
+	// the resturant the helper picks among the ones with free capacity, empty when all are full
+	string select_open(OrderHelper& helper, Order& order){
+		return resturantMap.select_resturant(helper, order.getDishId(), true);
+	}
+
+	// takes a slot at resName for the order, false when another order took the last one first
+	bool reserve(Order& order, string resName){
+		StageTimer timer(RESERVE);
+		Resturant* resturant = resturantMap.find_resturant(resName);
+		bool reserved = resturant->tryReserve();
+		// full now, or it was full and openResturants did not know yet
+		resturantMap.capacity_changed(*resturant);
+		if(reserved){
+			resturant->startOrder(order);
+			EventLog::sync();
+			Metrics::count(ORDERS_PLACED);
+		}else{
+			Metrics::count(CAPACITY_REJECTIONS);
+		}
+		return reserved;
+	}
+
+	// Places the order at the resturant the helper picks among those with free capacity.
+	// When every resturant serving the dish is full, the order waits in the pending
+	// orders of the one picked among all of them. Safe to call from many threads.
+	void place(Order& order, OrderHelper& helper){
+		StageTimer timer(PLACE_ORDER);
+		while(true){
+			string resName = select_open(helper, order);
+			if(resName.empty()){
+				break;
+			}
+			if(reserve(order, resName)){
+				return;
+			}
+		}
+
+		string resName = resturantMap.select_resturant(helper, order.getDishId(), false);
+		if(resName.empty()){
+			Metrics::count(ORDERS_NOT_PLACED);
+			return;
+		}
+		Resturant* resturant = resturantMap.find_resturant(resName);
+		resturant->queueOrder(order);
+		if(order.getStatus() == PLACED){
+			resturantMap.capacity_changed(*resturant);
+		}
+		EventLog::sync();
+		Metrics::count(order.getStatus() == PLACED ? ORDERS_PLACED : ORDERS_PENDING);
+	}
+
+	Order place_order(string userName, string dishName, string selection){
+		Order order = new_order(userName, dishName);
+		OrderHelper* curOrderSelector = select_helper(selection);
+		if(curOrderSelector != NULL){
+			place(order, *curOrderSelector);
+		}
+		return order;
+	}
+
+	// Places many orders at once, helpers[i] (NULL for none) picks for orders[i].
+	// The orders are grouped by dish and strategy, the groups go in the order their first
+	// order came. A group fills the resturants in the order of its ranking, with one
+	// reservation for all the slots it takes at each of them, and the rest wait at the
+	// resturant the strategy picks among all of them.
+	// The whole batch is made durable with one EventLog sync.
+	void place_batch(vector<Order>& orders, const vector<OrderHelper*>& helpers){
+		StageTimer timer(PLACE_BATCH);
+		map<pair<int, OrderHelper*>, size_t> groupOf;
+		vector<pair<pair<int, OrderHelper*>, vector<Order*>>> groups;
+		for(size_t i=0; i<orders.size(); ++i){
+			if(helpers[i] == NULL || orders[i].getDishId() < 0){
+				Metrics::count(ORDERS_NOT_PLACED);
+				continue;
+			}
+			pair<int, OrderHelper*> key = make_pair(orders[i].getDishId(), helpers[i]);
+			auto it = groupOf.find(key);
+			if(it == groupOf.end()){
+				it = groupOf.insert(make_pair(key, groups.size())).first;
+				groups.push_back(make_pair(key, vector<Order*>()));
+			}
+			groups[it->second].second.push_back(&orders[i]);
+		}
+
+		for(auto &group : groups){
+			int dishId = group.first.first;
+			OrderHelper& helper = *group.first.second;
+			vector<Order*>& members = group.second;
+			size_t next = 0;
+			// Rankings are read RANK_STEP resturants at a time, a resturant found full leaves
+			// the open index, so the next ranking starts with fresh ones
+			while(next < members.size()){
+				vector<string> ranked = resturantMap.rank_resturants(helper, dishId, min(members.size() - next, RANK_STEP), true);
+				if(ranked.empty())	break;
+				for(string &resName : ranked){
+					if(next == members.size())	break;
+					Resturant* resturant = resturantMap.find_resturant(resName);
+					int taken = resturant->tryReserveMany(members.size() - next);
+					resturantMap.capacity_changed(*resturant);
+					if(taken == 0){
+						Metrics::count(CAPACITY_REJECTIONS);
+						continue;
+					}
+					resturant->startOrders(&members[next], taken);
+					next += taken;
+				}
+			}
+			Metrics::count(ORDERS_PLACED, next);
+			if(next == members.size())	continue;
+
+			string resName = resturantMap.select_resturant(helper, dishId, false);
+			if(resName.empty()){
+				Metrics::count(ORDERS_NOT_PLACED, members.size() - next);
+				continue;
+			}
+			Resturant* resturant = resturantMap.find_resturant(resName);
+			for(; next<members.size(); ++next){
+				resturant->queueOrder(*members[next]);
+				Metrics::count(members[next]->getStatus() == PLACED ? ORDERS_PLACED : ORDERS_PENDING);
+			}
+			resturantMap.capacity_changed(*resturant);
+		}
+		EventLog::sync();
+	}
+
+	vector<Order> place_order_batch(const vector<OrderRequest>& requests){
+		vector<Order> orders;
+		vector<OrderHelper*> helpers;
+		orders.reserve(requests.size());
+		for(const OrderRequest &request : requests){
+			orders.push_back(new_order(request.userName, request.dishName));
+			helpers.push_back(select_helper(request.selection));
+		}
+		place_batch(orders, helpers);
+		return orders;
+	}
+
+	// Frees the slot of a finished order, the oldest pending order of the resturant
+	// takes it and is returned in promoted (id 0 when nobody was waiting)
+	bool complete_order(string resName, long long orderId, Order& promoted){
+		StageTimer timer(COMPLETE_ORDER);
+		Resturant* resturant = resturantMap.find_resturant(resName);
+		if(resturant == NULL || !resturant->completeOrder(orderId, Order::NO_HANDLE, promoted)){
+			return false;
+		}
+		resturantMap.capacity_changed(*resturant);
+		EventLog::sync();
+		Metrics::count(ORDERS_COMPLETED);
+		return true;
+	}
+
+	// the same for an order place_order or a promotion gave back, found by its pool handle in O(1)
+	bool complete_order(const Order& order, Order& promoted){
+		StageTimer timer(COMPLETE_ORDER);
+		Resturant* resturant = resturantMap.find_resturant(order.getResName());
+		if(resturant == NULL || !resturant->completeOrder(order.getId(), order.getHandle(), promoted)){
+			return false;
+		}
+		resturantMap.capacity_changed(*resturant);
+		EventLog::sync();
+		Metrics::count(ORDERS_COMPLETED);
+		return true;
+	}
+
+	void place_orders(){
+		int n;
+		cout << "Number of orders to be placed" << endl;
+		cin >> n;
+
+		vector<OrderRequest> requests;
+		for(int i=1; i<=n && cin; ++i){
+			requests.push_back(read_order());
+		}
+		for(Order &order : place_order_batch(requests)){
+			print_order(order);
+		}
+	}
+
+	void update_order_status(){
+		string resName;
+		long long orderId;
+		cout << "Resturant name:" << endl;
+		cin >> resName;
+		cout << "Completed order id:" << endl;
+		cin >> orderId;
+
+		Order promoted;
+		if(!complete_order(resName, orderId, promoted)){
+			cout << "WARNING: No such order being prepared" << endl;
+			return;
+		}
+		cout << "Order " << orderId << " completed" << endl;
+		if(promoted.getId() != 0){
+			cout << "Order placed at:" << resName << ", order id:" << promoted.getId() << endl;
+		}
+	}
+
+};
+
+#endif
@@ -0,0 +1,189 @@
+#ifndef FOOD_ORDERING_ORDER_PIPELINE
+#define FOOD_ORDERING_ORDER_PIPELINE
+#include <string>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include "bounded_queue.hpp"
+#include "order_manager.hpp"
+
+using namespace std;
+
+// Places orders in stages, each stage has its own threads and hands its orders to
+// the next one through a BoundedQueue:
+//   submit (any thread) -> intake -> selection -> reservation -> confirmation
+// Selection picks the resturant with the OrderHelper of the order, reservation takes
+// the slot (and picks again when another order took it first), confirmation counts
+// the results and hands every order to onConfirm on a single thread. An order the
+// EventLog could not make durable is counted in notSaved and not confirmed.
+// A full queue holds the stage before it back, so submit slows down at peak instead
+// of piling up orders.
+class OrderPipeline{
+	struct Job{
+		Order order;
+		OrderHelper* helper = NULL;
+		string resName;
+		bool saved = true;
+	};
+
+	OrderManager orderManager;
+	BoundedQueue<Job> intake;
+	BoundedQueue<Job> selected;
+	BoundedQueue<Job> confirmed;
+	function<void(Order&)> onConfirm;
+	vector<thread> workers;
+	atomic<bool> stopping;
+	atomic<long long> submitted;
+	atomic<long long> finished;
+
+	// spins first, then gives the core away, then sleeps while there is nothing to do
+	static void wait(int &idle){
+		idle++;
+		if(idle < 64){
+			return;
+		}else if(idle < 128){
+			this_thread::yield();
+		}else{
+			this_thread::sleep_for(chrono::microseconds(50));
+		}
+	}
+
+	static void push(BoundedQueue<Job> &queue, Job &job){
+		int idle = 0;
+		while(!queue.tryPush(move(job))){
+			wait(idle);
+		}
+	}
+
+	void select(){
+		Job job;
+		int idle = 0;
+		while(true){
+			if(!intake.tryPop(job)){
+				if(stopping.load())	return;
+				wait(idle);
+				continue;
+			}
+			idle = 0;
+			if(job.helper != NULL){
+				job.resName = orderManager.select_open(*job.helper, job.order);
+				if(!job.resName.empty()){
+					push(selected, job);
+					continue;
+				}
+				// every resturant serving the dish is full, wait in a pending queue
+				try{
+					orderManager.place(job.order, *job.helper);
+				}catch(const EventLogFailure&){
+					job.saved = false;
+				}
+			}
+			push(confirmed, job);
+		}
+	}
+
+	void reserve(){
+		Job job;
+		int idle = 0;
+		while(true){
+			if(!selected.tryPop(job)){
+				if(stopping.load())	return;
+				wait(idle);
+				continue;
+			}
+			idle = 0;
+			try{
+				if(!orderManager.reserve(job.order, job.resName)){
+					orderManager.place(job.order, *job.helper);
+				}
+			}catch(const EventLogFailure&){
+				job.saved = false;
+			}
+			push(confirmed, job);
+		}
+	}
+
+	void confirm(){
+		Job job;
+		int idle = 0;
+		while(true){
+			if(!confirmed.tryPop(job)){
+				if(stopping.load())	return;
+				wait(idle);
+				continue;
+			}
+			idle = 0;
+			if(!job.saved){
+				notSaved++;
+				finished.fetch_add(1, memory_order_release);
+				continue;
+			}
+			OrderStatus status = job.order.getStatus();
+			if(status == PLACED)	placed++;
+			else if(status == PENDING)	pending++;
+			else	notPlaced++;
+			if(onConfirm)	onConfirm(job.order);
+			finished.fetch_add(1, memory_order_release);
+		}
+	}
+
+public:
+	// written by the confirmation thread only, read them after drain()
+	long long placed;
+	long long pending;
+	long long notPlaced;
+	long long notSaved;
+
+	OrderPipeline(int selectors, int reservers, size_t queueSize = 4096, function<void(Order&)> onConfirm = nullptr)
+		: intake(queueSize), selected(queueSize), confirmed(queueSize){
+		this->onConfirm = onConfirm;
+		this->stopping = false;
+		this->submitted = 0;
+		this->finished = 0;
+		this->placed = 0;
+		this->pending = 0;
+		this->notPlaced = 0;
+		this->notSaved = 0;
+		for(int i=0; i<selectors; ++i)	workers.push_back(thread(&OrderPipeline::select, this));
+		for(int i=0; i<reservers; ++i)	workers.push_back(thread(&OrderPipeline::reserve, this));
+		workers.push_back(thread(&OrderPipeline::confirm, this));
+	}
+
+	~OrderPipeline(){
+		stop();
+	}
+
+	// queues the order and returns its id, waits while the intake queue is full
+	long long submit(string userName, string dishName, string selection){
+		Job job;
+		job.order = orderManager.new_order(userName, dishName);
+		job.helper = orderManager.select_helper(selection);
+		long long id = job.order.getId();
+		submitted++;
+		push(intake, job);
+		return id;
+	}
+
+	// waits until every order submitted so far is confirmed
+	void drain(){
+		int idle = 0;
+		while(finished.load(memory_order_acquire) < submitted.load()){
+			wait(idle);
+		}
+	}
+
+	// finishes the orders already submitted and stops the threads, submit must not run any more
+	void stop(){
+		if(workers.empty())	return;
+		drain();
+		stopping = true;
+		for(thread &worker : workers){
+			worker.join();
+		}
+		workers.clear();
+	}
+};
+
+#endif
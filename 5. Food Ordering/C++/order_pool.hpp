@@ -0,0 +1,147 @@
+#ifndef FOOD_ORDERING_ORDER_POOL
+#define FOOD_ORDERING_ORDER_POOL
+#include <atomic>
+#include <mutex>
+#include <cstdint>
+#include "order.hpp"
+
+using namespace std;
+
+// Every order a resturant holds lives in a slot of this pool, named by a 32 bit
+// handle that stays the same for the life of the order. Slots come in slabs of
+// SLAB_SIZE that are never given back; free slots are kept on a lock free stack
+// (the head carries a counter against ABA). Only adding a slab uses the heap, after
+// warm up taking and giving back a slot is one compare and swap.
+class OrderPool{
+	static const int SLAB_BITS = 12;
+	static const uint32_t SLAB_SIZE = 1u << SLAB_BITS;
+	static const int MAX_SLABS = 1 << 14;
+
+	struct Slab{
+		Order orders[SLAB_SIZE];
+		atomic<uint32_t> nextFree[SLAB_SIZE];
+	};
+
+	inline static atomic<Slab*> slabs[MAX_SLABS];
+	inline static atomic<int> slabCount{0};
+	inline static mutex growLock;
+	inline static atomic<uint64_t> freeHead{Order::NO_HANDLE};	// counter << 32 | handle
+
+	static atomic<uint32_t>& nextFree(uint32_t handle){
+		return slabs[handle >> SLAB_BITS].load(memory_order_acquire)->nextFree[handle & (SLAB_SIZE - 1)];
+	}
+
+	// pushes first .. last, already linked through nextFree, on the free stack
+	static void pushChain(uint32_t first, uint32_t last){
+		uint64_t head = freeHead.load(memory_order_relaxed);
+		while(true){
+			nextFree(last).store(uint32_t(head), memory_order_relaxed);
+			uint64_t replaced = ((head >> 32) + 1) << 32 | first;
+			if(freeHead.compare_exchange_weak(head, replaced, memory_order_release, memory_order_relaxed)){
+				return;
+			}
+		}
+	}
+
+	static void addSlab(){
+		lock_guard<mutex> lock(growLock);
+		if(uint32_t(freeHead.load()) != Order::NO_HANDLE)	return;	// another thread added one
+		int slab = slabCount.load();
+		if(slab == MAX_SLABS)	throw bad_alloc();
+		slabs[slab].store(new Slab(), memory_order_release);
+		slabCount.store(slab + 1);
+		uint32_t first = uint32_t(slab) << SLAB_BITS;
+		for(uint32_t i=0; i+1<SLAB_SIZE; ++i){
+			nextFree(first + i).store(first + i + 1, memory_order_relaxed);
+		}
+		pushChain(first, first + SLAB_SIZE - 1);
+	}
+
+public:
+	// a free slot holding a copy of order, its handle is set in the copy and in order
+	static uint32_t allocate(Order& order){
+		uint64_t head = freeHead.load(memory_order_acquire);
+		while(true){
+			uint32_t handle = uint32_t(head);
+			if(handle == Order::NO_HANDLE){
+				addSlab();
+				head = freeHead.load(memory_order_acquire);
+				continue;
+			}
+			uint64_t replaced = ((head >> 32) + 1) << 32 | nextFree(handle).load(memory_order_relaxed);
+			if(freeHead.compare_exchange_weak(head, replaced, memory_order_acquire, memory_order_acquire)){
+				order.setHandle(handle);
+				get(handle) = order;
+				return handle;
+			}
+		}
+	}
+
+	// the slot goes back to the pool, marked COMPLETED so a stale handle to it matches nothing
+	static void release(uint32_t handle){
+		Order& order = get(handle);
+		order.setHandle(Order::NO_HANDLE);
+		order.setStatus(COMPLETED);
+		pushChain(handle, handle);
+	}
+
+	static Order& get(uint32_t handle){
+		return slabs[handle >> SLAB_BITS].load(memory_order_acquire)->orders[handle & (SLAB_SIZE - 1)];
+	}
+
+	static long long capacity(){
+		return (long long)slabCount.load() * SLAB_SIZE;
+	}
+};
+
+// First in first out list of pooled orders, linked through their prev / next handles.
+// Whoever owns the list guards it, OrderPool only hands out the slots.
+class OrderList{
+	uint32_t head;
+	uint32_t tail;
+	int count;
+
+public:
+	OrderList(){
+		head = Order::NO_HANDLE;
+		tail = Order::NO_HANDLE;
+		count = 0;
+	}
+
+	int size(){
+		return count;
+	}
+
+	bool empty(){
+		return count == 0;
+	}
+
+	uint32_t front(){
+		return head;
+	}
+
+	uint32_t next(uint32_t handle){
+		return OrderPool::get(handle).next;
+	}
+
+	void pushBack(uint32_t handle){
+		Order& order = OrderPool::get(handle);
+		order.prev = tail;
+		order.next = Order::NO_HANDLE;
+		if(tail == Order::NO_HANDLE)	head = handle;
+		else	OrderPool::get(tail).next = handle;
+		tail = handle;
+		count++;
+	}
+
+	void remove(uint32_t handle){
+		Order& order = OrderPool::get(handle);
+		if(order.prev == Order::NO_HANDLE)	head = order.next;
+		else	OrderPool::get(order.prev).next = order.next;
+		if(order.next == Order::NO_HANDLE)	tail = order.prev;
+		else	OrderPool::get(order.next).prev = order.prev;
+		count--;
+	}
+};
+
+#endif
@@ -0,0 +1,272 @@
+#ifndef FOOD_ORDERING_RESTURANT
+#define FOOD_ORDERING_RESTURANT
+#include <string>
+#include <atomic>
+#include <mutex>
+#include <algorithm>
+#include "menu.hpp"
+#include "geo_index.hpp"
+#include "order.hpp"
+#include "order_pool.hpp"
+#include "event_log.hpp"
+
+using namespace std;
+
+// cur_limit counts the orders being prepared, it never goes over MAX_LIMIT.
+// A slot is taken with a compare and swap so many threads can reserve at once,
+// the order lists are guarded by orderLock. The orders themselves live in the OrderPool. The menu and rating are changed under
+// menuLock, where ResturantMap also keeps indexedFull in step with its indexes.
+// Order changes go to the EventLog under orderLock, so it sees them in their real order.
+class Resturant{
+	string name;
+	int rating;
+	Location location;
+	Menu menu;
+	OrderList currentOrders;
+	OrderList pendingOrders;
+	int MAX_LIMIT;
+	atomic<int> cur_limit;
+	mutex orderLock;
+	mutex menuLock;
+	atomic<bool> indexedFull;
+
+public:
+	Resturant(){
+		this->rating = 0;
+		this->MAX_LIMIT = 0;
+		this->cur_limit = 0;
+		this->indexedFull = false;
+	}
+
+	Resturant(string name, int rating, int maxLimit, Location location = Location()){
+		this->name = name;
+		this->rating = rating;
+		this->location = location;
+		this->MAX_LIMIT = maxLimit;
+		this->cur_limit = 0;
+		this->indexedFull = false;
+	}
+
+	Resturant(const Resturant& other){
+		*this = other;
+	}
+
+	// copies the resturant without its orders, pooled orders have one owner
+	Resturant& operator=(const Resturant& other){
+		this->name = other.name;
+		this->rating = other.rating;
+		this->location = other.location;
+		this->menu = other.menu;
+		this->currentOrders = OrderList();
+		this->pendingOrders = OrderList();
+		this->MAX_LIMIT = other.MAX_LIMIT;
+		this->cur_limit = 0;
+		this->indexedFull = other.indexedFull.load();
+		return *this;
+	}
+
+	string getName(){
+		return this->name;
+	}
+
+	int getRating(){
+		return this->rating;
+	}
+
+	void setRating(int rating){
+		this->rating = rating;
+	}
+
+	Location getLocation(){
+		return this->location;
+	}
+
+	void setLocation(Location location){
+		this->location = location;
+	}
+
+	Menu& getMenu(){
+		return this->menu;
+	}
+
+	mutex& getMenuLock(){
+		return this->menuLock;
+	}
+
+	// true while the resturant is left out of the indexes of open resturants
+	bool isIndexedFull(){
+		return this->indexedFull.load();
+	}
+
+	void setIndexedFull(bool full){
+		this->indexedFull.store(full);
+	}
+
+	bool add_to_menu(string dishName, int price){
+		return menu.addToMenu(dishName, price);
+	}
+
+	bool add_to_menu(int dishId, int price){
+		return menu.addToMenu(dishId, price);
+	}
+
+	bool update_in_menu(string dishName, int price){
+		return menu.updateMenu(dishName, price);
+	}
+
+	bool update_in_menu(int dishId, int price){
+		return menu.updateMenu(dishId, price);
+	}
+
+	// (dishId, price) pairs, adds the new dishes and reprices the others in one step
+	void update_menu(const vector<pair<int, int>>& changes){
+		menu.applyChanges(changes);
+	}
+
+	int getMaxLimit(){
+		return this->MAX_LIMIT;
+	}
+
+	int getCurLimit(){
+		return this->cur_limit.load();
+	}
+
+	bool isFull(){
+		return getCurLimit() >= MAX_LIMIT;
+	}
+
+	// Takes one slot of capacity, false when the resturant is full.
+	// Sequentially consistent, ResturantMap::capacity_changed pairs it with indexedFull.
+	bool tryReserve(){
+		int cur = cur_limit.load();
+		while(cur < MAX_LIMIT){
+			if(cur_limit.compare_exchange_weak(cur, cur + 1)){
+				return true;
+			}
+		}
+		return false;
+	}
+
+	// Takes up to wanted slots at once, returns how many it got
+	int tryReserveMany(int wanted){
+		int cur = cur_limit.load();
+		while(cur < MAX_LIMIT){
+			int taken = min(wanted, MAX_LIMIT - cur);
+			if(cur_limit.compare_exchange_weak(cur, cur + taken)){
+				return taken;
+			}
+		}
+		return 0;
+	}
+
+	// count orders that already hold a slot each from tryReserveMany, under one lock
+	void startOrders(Order* const* orders, int count){
+		lock_guard<mutex> lock(orderLock);
+		for(int i=0; i<count; ++i){
+			Order& order = *orders[i];
+			order.setResName(&this->name);
+			order.setStatus(PLACED);
+			currentOrders.pushBack(OrderPool::allocate(order));
+			EventLog::orderPlaced(order);
+		}
+	}
+
+	// the order already holds a slot from tryReserve
+	void startOrder(Order& order){
+		order.setResName(&this->name);
+		order.setStatus(PLACED);
+		uint32_t handle = OrderPool::allocate(order);
+		lock_guard<mutex> lock(orderLock);
+		currentOrders.pushBack(handle);
+		EventLog::orderPlaced(order);
+	}
+
+	// Takes a slot if one is free by now, otherwise waits in pendingOrders.
+	// Done under orderLock so a completing order either frees the slot first or sees this order waiting.
+	void queueOrder(Order& order){
+		order.setResName(&this->name);
+		lock_guard<mutex> lock(orderLock);
+		if(tryReserve()){
+			order.setStatus(PLACED);
+			currentOrders.pushBack(OrderPool::allocate(order));
+		}else{
+			order.setStatus(PENDING);
+			pendingOrders.pushBack(OrderPool::allocate(order));
+		}
+		EventLog::orderPlaced(order);
+	}
+
+	// puts back an order read from the event log or a snapshot as it was,
+	// a current order takes its slot again
+	void restoreOrder(Order order){
+		order.setResName(&this->name);
+		lock_guard<mutex> lock(orderLock);
+		if(order.getStatus() == PLACED){
+			cur_limit.fetch_add(1);
+			currentOrders.pushBack(OrderPool::allocate(order));
+		}else{
+			pendingOrders.pushBack(OrderPool::allocate(order));
+		}
+	}
+
+	// visit(const Order&) for the current orders and then the pending ones, oldest first
+	template<typename Visit>
+	void forEachOrder(Visit visit){
+		lock_guard<mutex> lock(orderLock);
+		for(uint32_t h=currentOrders.front(); h!=Order::NO_HANDLE; h=currentOrders.next(h)){
+			visit(OrderPool::get(h));
+		}
+		for(uint32_t h=pendingOrders.front(); h!=Order::NO_HANDLE; h=pendingOrders.next(h)){
+			visit(OrderPool::get(h));
+		}
+	}
+
+	// Finishes a current order, found by its handle or, without one, by its id among
+	// the current orders. The oldest pending order takes over its slot and is returned
+	// in promoted, without one the slot is released. False for an unknown order.
+	bool completeOrder(long long orderId, uint32_t handle, Order& promoted){
+		lock_guard<mutex> lock(orderLock);
+		if(handle == Order::NO_HANDLE){
+			for(uint32_t h=currentOrders.front(); h!=Order::NO_HANDLE; h=currentOrders.next(h)){
+				if(OrderPool::get(h).getId() == orderId){
+					handle = h;
+					break;
+				}
+			}
+			if(handle == Order::NO_HANDLE)	return false;
+		}
+		Order& order = OrderPool::get(handle);
+		// the slot may already hold a later order of another resturant
+		if(order.getId() != orderId || order.getHandle() != handle || !order.isHeldBy(&this->name)
+		   || order.getStatus() != PLACED){
+			return false;
+		}
+		currentOrders.remove(handle);
+		OrderPool::release(handle);
+		if(pendingOrders.empty()){
+			cur_limit.fetch_sub(1);
+			promoted = Order();
+			EventLog::orderCompleted(this->name, orderId, promoted);
+			return true;
+		}
+		uint32_t next = pendingOrders.front();
+		pendingOrders.remove(next);
+		currentOrders.pushBack(next);
+		OrderPool::get(next).setStatus(PLACED);
+		promoted = OrderPool::get(next);
+		EventLog::orderCompleted(this->name, orderId, promoted);
+		return true;
+	}
+
+	int currentCount(){
+		lock_guard<mutex> lock(orderLock);
+		return currentOrders.size();
+	}
+
+	int pendingCount(){
+		lock_guard<mutex> lock(orderLock);
+		return pendingOrders.size();
+	}
+};
+
+#endif
@@ -0,0 +1,92 @@
+#ifndef FOOD_ORDERING_RESTURANT_INDEX
+#define FOOD_ORDERING_RESTURANT_INDEX
+#include <string>
+#include <set>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "geo_index.hpp"
+
+using namespace std;
+
+// Resturants kept in selection order for every dish, so placing an order
+// does not scan all of them: by price (cheapest first) and by rating (best first),
+// ties go to the smaller name. Every change costs O(log n).
+// Every dish also keeps its resturants on the map, for picking among the close ones.
+class ResturantIndex{
+	struct DishIndex{
+		set<pair<int, string>> byPrice;		// (price, name)
+		set<pair<int, string>> byRating;	// (-rating, name)
+		GeoIndex near;
+	};
+	unordered_map<int, DishIndex> dishes;		// by dish id
+
+	static vector<string> firstNames(const set<pair<int, string>>& ranked, int count){
+		vector<string> names;
+		for(auto it = ranked.begin(); it != ranked.end() && (int)names.size() < count; ++it){
+			names.push_back(it->second);
+		}
+		return names;
+	}
+
+public:
+	ResturantIndex(){}
+
+	void addDish(string resName, int rating, Location location, int dishId, int price){
+		DishIndex& dish = dishes[dishId];
+		dish.byPrice.insert(make_pair(price, resName));
+		dish.byRating.insert(make_pair(-rating, resName));
+		dish.near.add(resName, rating, location);
+	}
+
+	void removeDish(string resName, int rating, Location location, int dishId, int price){
+		auto it = dishes.find(dishId);
+		if(it == dishes.end())	return;
+		it->second.byPrice.erase(make_pair(price, resName));
+		it->second.byRating.erase(make_pair(-rating, resName));
+		it->second.near.remove(resName, location);
+		if(it->second.byPrice.empty())	dishes.erase(it);
+	}
+
+	void updatePrice(string resName, int dishId, int oldPrice, int newPrice){
+		DishIndex& dish = dishes[dishId];
+		dish.byPrice.erase(make_pair(oldPrice, resName));
+		dish.byPrice.insert(make_pair(newPrice, resName));
+	}
+
+	// name of the cheapest resturant serving the dish, empty when nobody serves it
+	string cheapest(int dishId){
+		auto it = dishes.find(dishId);
+		return it == dishes.end() ? "" : it->second.byPrice.begin()->second;
+	}
+
+	// name of the best rated resturant serving the dish, empty when nobody serves it
+	string bestRated(int dishId){
+		auto it = dishes.find(dishId);
+		return it == dishes.end() ? "" : it->second.byRating.begin()->second;
+	}
+
+	// names of the count cheapest resturants serving the dish, cheapest first
+	vector<string> cheapest(int dishId, int count){
+		auto it = dishes.find(dishId);
+		return it == dishes.end() ? vector<string>() : firstNames(it->second.byPrice, count);
+	}
+
+	// names of the count best rated resturants serving the dish, best first
+	vector<string> bestRated(int dishId, int count){
+		auto it = dishes.find(dishId);
+		return it == dishes.end() ? vector<string>() : firstNames(it->second.byRating, count);
+	}
+
+	// names of the k best rated resturants within radius km of the location serving the dish, best first
+	vector<string> bestRatedNear(int dishId, Location location, double radius, int k){
+		auto it = dishes.find(dishId);
+		return it == dishes.end() ? vector<string>() : it->second.near.bestRatedNear(location, radius, k);
+	}
+
+	void clear(){
+		dishes.clear();
+	}
+};
+
+#endif
@@ -0,0 +1,78 @@
+#ifndef FOOD_ORDERING_RESTURANT_MANAGER
+#define FOOD_ORDERING_RESTURANT_MANAGER
+#include <iostream>
+#include <string>
+#include <vector>
+#include <utility>
+#include "resturant_map.hpp"
+
+using namespace std;
+
+class ResturantManager{
+	ResturantMap resturantMap;
+
+public:
+	ResturantManager(){}
+
+	void add_resturant_menu(){
+		string resName;
+		string dishName;
+		int price;
+		bool added = false;
+		do{
+			cout << "Resturant name:" << endl;
+			cin >> resName;
+			cout << "dish name:" << endl;
+			cin >> dishName;
+			cout << "Price:" << endl;
+			cin >> price;
+			if(resturantMap.add_to_menu(resName, dishName, price)){
+				added = true;
+				EventLog::sync();
+			}
+		}while(added != true && cin);
+	}
+
+	void update_resturant_menu(){
+		string resName;
+		string dishName;
+		int price;
+		bool updated = false;
+		do{
+			cout << "Resturant name:" << endl;
+			cin >> resName;
+			cout << "dish name:" << endl;
+			cin >> dishName;
+			cout << "Price:" << endl;
+			cin >> price;
+			if(resturantMap.update_in_menu(resName, dishName, price)){
+				updated = true;
+				EventLog::sync();
+			}
+		}while(updated != true && cin);
+	}
+
+	// many dishes of one resturant in one go, new dishes are added and the others repriced
+	void update_resturant_menu_in_bulk(){
+		string resName;
+		int n;
+		cout << "Resturant name:" << endl;
+		cin >> resName;
+		cout << "Number of dishes:" << endl;
+		cin >> n;
+		vector<pair<string, int>> changes;
+		for(int i=0; i<n && cin; ++i){
+			string dishName;
+			int price;
+			cout << "dish name and price:" << endl;
+			cin >> dishName >> price;
+			changes.push_back(make_pair(dishName, price));
+		}
+		if(cin && resturantMap.update_menu(resName, changes)){
+			EventLog::sync();
+			cout << "Menu of " << resName << " updated with " << changes.size() << " dishes" << endl;
+		}
+	}
+};
+
+#endif
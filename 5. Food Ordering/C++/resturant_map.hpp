@@ -0,0 +1,352 @@
+#ifndef FOOD_ORDERING_RESTURANT_MAP
+#define FOOD_ORDERING_RESTURANT_MAP
+#include <iostream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include <memory>
+#include <algorithm>
+#include <utility>
+#include <mutex>
+#include <shared_mutex>
+#include "resturant.hpp"
+#include "resturant_index.hpp"
+#include "order_helper.hpp"
+#include "event_log.hpp"
+#include "metrics.hpp"
+
+using namespace std;
+
+// Every ResturantMap shares the same resturants.
+// Menus and ratings are changed through here so the indexes follow them:
+// allResturants holds every resturant, openResturants only those with free capacity,
+// so selection never walks over full resturants.
+// The indexes are split by dish id into shards with a lock each, a menu change only
+// waits for orders of the dishes in its own shard and orders for other dishes go on.
+// Orders may be placed from many threads together with menu, rating and capacity
+// changes; add_resturant and clear must not run while orders are being placed.
+// Every change but clear is put in the EventLog, EventLog::sync() makes it durable.
+class ResturantMap{
+	static const int SHARDS = 16;
+
+	struct Shard{
+		ResturantIndex allResturants;
+		ResturantIndex openResturants;
+		shared_mutex lock;
+	};
+
+	inline static unordered_map<string, Resturant> resturantMap;
+	inline static Shard shards[SHARDS];
+
+	static Shard& shardOf(int dishId){
+		return shards[dishId % SHARDS];
+	}
+
+	// every dish of the resturant in or out of the indexes, called under its menuLock
+	void indexMenu(Resturant& resturant, bool add){
+		bool open = !resturant.isIndexedFull();
+		resturant.getMenu().forEachDish([&](int dishId, int price){
+			Shard& shard = shardOf(dishId);
+			unique_lock<shared_mutex> lock(shard.lock);
+			if(add){
+				shard.allResturants.addDish(resturant.getName(), resturant.getRating(), resturant.getLocation(), dishId, price);
+				if(open)	shard.openResturants.addDish(resturant.getName(), resturant.getRating(), resturant.getLocation(), dishId, price);
+			}else{
+				shard.allResturants.removeDish(resturant.getName(), resturant.getRating(), resturant.getLocation(), dishId, price);
+				if(open)	shard.openResturants.removeDish(resturant.getName(), resturant.getRating(), resturant.getLocation(), dishId, price);
+			}
+		});
+	}
+
+	void setOpen(Resturant& resturant, bool open){
+		resturant.getMenu().forEachDish([&](int dishId, int price){
+			Shard& shard = shardOf(dishId);
+			unique_lock<shared_mutex> lock(shard.lock);
+			if(open){
+				shard.openResturants.addDish(resturant.getName(), resturant.getRating(), resturant.getLocation(), dishId, price);
+			}else{
+				shard.openResturants.removeDish(resturant.getName(), resturant.getRating(), resturant.getLocation(), dishId, price);
+			}
+		});
+	}
+
+public:
+	ResturantMap(){}
+
+	void initiate(){
+		int n = 0;
+		cout << "Number of resturant:" << endl;
+		cin >> n;
+
+		for(int i=0; i<n; ++i){
+			string name;
+			int rating, maxLimit;
+			cout << "Name:" << endl;
+			if(!(cin >> name)){
+				break;
+			}
+			cout << "Rating:" << endl;
+			if(!(cin >> rating)){
+				break;
+			}
+			cout << "Maximum orders at a time:" << endl;
+			if(!(cin >> maxLimit)){
+				break;
+			}
+			add_resturant(Resturant(name, rating, maxLimit));
+		}
+		EventLog::sync();
+	}
+
+	// A resturant added again under its name replaces the old one, unless the old one
+	// still has current or pending orders: those stay with it and false is returned.
+	bool add_resturant(Resturant resturant){
+		auto it = resturantMap.find(resturant.getName());
+		if(it != resturantMap.end()){
+			if(it->second.currentCount() > 0 || it->second.pendingCount() > 0){
+				cout << "WARNING: Resturant " << resturant.getName() << " has orders in progress, not replaced" << endl;
+				return false;
+			}
+			indexMenu(it->second, false);
+		}
+		resturant.setIndexedFull(resturant.isFull());
+		indexMenu(resturant, true);
+		resturantMap[resturant.getName()] = resturant;
+		if(EventLog::isOpen()){
+			vector<pair<string, int>> dishes;
+			resturant.getMenu().forEachDish([&](int dishId, int price){
+				dishes.push_back(make_pair(DishInterner::name(dishId), price));
+			});
+			EventLog::resturantAdded(resturant.getName(), resturant.getRating(), resturant.getMaxLimit(),
+									 resturant.getLocation(), dishes);
+		}
+		return true;
+	}
+
+	bool is_present(string resName){
+		return resturantMap.count(resName);
+	}
+
+	// read only, use add_to_menu / update_in_menu / update_rating for changes
+	Resturant& operator[](string resName){
+		return resturantMap[resName];
+	}
+
+	// NULL when there is no such resturant
+	Resturant* find_resturant(const string& resName){
+		auto it = resturantMap.find(resName);
+		return it == resturantMap.end() ? NULL : &it->second;
+	}
+
+	bool add_to_menu(string resName, string dishName, int price){
+		StageTimer timer(MENU_UPDATE);
+		Resturant* resturant = find_resturant(resName);
+		if(resturant == NULL){
+			cout << "WARNING: Resturant not present" << endl;
+			return false;
+		}
+		int dishId = DishInterner::intern(dishName);
+		lock_guard<mutex> menuLock(resturant->getMenuLock());
+		if(!resturant->add_to_menu(dishId, price)){
+			return false;
+		}
+		Shard& shard = shardOf(dishId);
+		unique_lock<shared_mutex> lock(shard.lock);
+		shard.allResturants.addDish(resName, resturant->getRating(), resturant->getLocation(), dishId, price);
+		if(!resturant->isIndexedFull()){
+			shard.openResturants.addDish(resName, resturant->getRating(), resturant->getLocation(), dishId, price);
+		}
+		EventLog::menuChanged(resName, {make_pair(dishName, price)});
+		Metrics::count(MENU_CHANGES);
+		return true;
+	}
+
+	bool update_in_menu(string resName, string dishName, int price){
+		StageTimer timer(MENU_UPDATE);
+		Resturant* resturant = find_resturant(resName);
+		if(resturant == NULL){
+			cout << "WARNING: Resturant not present" << endl;
+			return false;
+		}
+		int dishId = DishInterner::find(dishName);
+		lock_guard<mutex> menuLock(resturant->getMenuLock());
+		int oldPrice = resturant->getMenu().getPrice(dishId);
+		if(!resturant->update_in_menu(dishId, price)){
+			return false;
+		}
+		Shard& shard = shardOf(dishId);
+		unique_lock<shared_mutex> lock(shard.lock);
+		shard.allResturants.updatePrice(resName, dishId, oldPrice, price);
+		if(!resturant->isIndexedFull()){
+			shard.openResturants.updatePrice(resName, dishId, oldPrice, price);
+		}
+		EventLog::menuChanged(resName, {make_pair(dishName, price)});
+		Metrics::count(MENU_CHANGES);
+		return true;
+	}
+
+	// Applies every (dish name, price) change to the menu of resName at once: a dish
+	// not on the menu is added, one on it gets the new price, the last change of a
+	// dish wins. The new menu is built aside and swapped in, so readers of the menu see
+	// all of the changes or none. The indexes then get only the differences, with one
+	// write lock per shard. False and no change when a price is negative.
+	bool update_menu(string resName, const vector<pair<string, int>>& changes){
+		StageTimer timer(MENU_UPDATE);
+		Resturant* resturant = find_resturant(resName);
+		if(resturant == NULL){
+			cout << "WARNING: Resturant not present" << endl;
+			return false;
+		}
+		vector<pair<int, int>> idChanges;
+		idChanges.reserve(changes.size());
+		for(auto &change : changes){
+			if(change.second < 0){
+				cout << "WARNING: Negative price for " << change.first << ", menu not changed" << endl;
+				return false;
+			}
+			idChanges.push_back(make_pair(DishInterner::intern(change.first), change.second));
+		}
+
+		lock_guard<mutex> menuLock(resturant->getMenuLock());
+		shared_ptr<const Menu::Table> old = resturant->getMenu().snapshot();
+		resturant->update_menu(idChanges);
+		shared_ptr<const Menu::Table> now = resturant->getMenu().snapshot();
+
+		// grouped by shard, the final price of every dish is in the new menu
+		sort(idChanges.begin(), idChanges.end(), [](const pair<int, int>& a, const pair<int, int>& b){
+			return make_pair(a.first % SHARDS, a.first) < make_pair(b.first % SHARDS, b.first);
+		});
+		bool open = !resturant->isIndexedFull();
+		int rating = resturant->getRating();
+		Location location = resturant->getLocation();
+		size_t begin = 0;
+		while(begin < idChanges.size()){
+			int shardId = idChanges[begin].first % SHARDS;
+			size_t end = begin;
+			while(end < idChanges.size() && idChanges[end].first % SHARDS == shardId)	end++;
+			Shard& shard = shards[shardId];
+			unique_lock<shared_mutex> lock(shard.lock);
+			for(size_t i=begin; i<end; ++i){
+				int dishId = idChanges[i].first;
+				if(i > begin && idChanges[i-1].first == dishId)	continue;
+				int oldPrice = old->getPrice(dishId);
+				int price = now->getPrice(dishId);
+				if(oldPrice == price)	continue;
+				if(oldPrice < 0){
+					shard.allResturants.addDish(resName, rating, location, dishId, price);
+					if(open)	shard.openResturants.addDish(resName, rating, location, dishId, price);
+				}else{
+					shard.allResturants.updatePrice(resName, dishId, oldPrice, price);
+					if(open)	shard.openResturants.updatePrice(resName, dishId, oldPrice, price);
+				}
+			}
+			begin = end;
+		}
+		EventLog::menuChanged(resName, changes);
+		Metrics::count(MENU_CHANGES);
+		return true;
+	}
+
+	bool update_rating(string resName, int rating){
+		StageTimer timer(MENU_UPDATE);
+		Resturant* resturant = find_resturant(resName);
+		if(resturant == NULL){
+			cout << "WARNING: Resturant not present" << endl;
+			return false;
+		}
+		lock_guard<mutex> menuLock(resturant->getMenuLock());
+		indexMenu(*resturant, false);
+		resturant->setRating(rating);
+		indexMenu(*resturant, true);
+		EventLog::ratingChanged(resName, rating);
+		Metrics::count(MENU_CHANGES);
+		return true;
+	}
+
+	bool update_location(string resName, Location location){
+		Resturant* resturant = find_resturant(resName);
+		if(resturant == NULL){
+			cout << "WARNING: Resturant not present" << endl;
+			return false;
+		}
+		lock_guard<mutex> menuLock(resturant->getMenuLock());
+		indexMenu(*resturant, false);
+		resturant->setLocation(location);
+		indexMenu(*resturant, true);
+		EventLog::locationChanged(resName, location);
+		return true;
+	}
+
+	// names of the k best rated resturants within radius km of the location that serve
+	// the dish, among the ones with free capacity or among all of them, best first
+	vector<string> nearby_resturants(int dishId, Location location, double radius, int k, bool onlyOpen){
+		if(dishId < 0)	return vector<string>();
+		Shard& shard = shardOf(dishId);
+		shared_lock<shared_mutex> lock(shard.lock);
+		return (onlyOpen ? shard.openResturants : shard.allResturants).bestRatedNear(dishId, location, radius, k);
+	}
+
+	// name of the resturant the helper picks for the dish, among the ones with
+	// free capacity or among all of them, empty when there is none
+	string select_resturant(OrderHelper& helper, int dishId, bool onlyOpen){
+		if(dishId < 0)	return "";
+		StageTimer timer(SELECT);
+		Shard& shard = shardOf(dishId);
+		shared_lock<shared_mutex> lock(shard.lock);
+		return helper.select_resturant_by_strategy(onlyOpen ? shard.openResturants : shard.allResturants, dishId);
+	}
+
+	// the first count resturants the helper would pick for the dish, best first
+	vector<string> rank_resturants(OrderHelper& helper, int dishId, int count, bool onlyOpen){
+		if(dishId < 0)	return vector<string>();
+		StageTimer timer(SELECT);
+		Shard& shard = shardOf(dishId);
+		shared_lock<shared_mutex> lock(shard.lock);
+		return helper.rank_resturants_by_strategy(onlyOpen ? shard.openResturants : shard.allResturants, dishId, count);
+	}
+
+	// Call after a slot of the resturant was taken or given back, moves it in or out
+	// of openResturants when that changed. Costs two atomic loads when nothing changed.
+	// The slot change and indexedFull are both sequentially consistent: either this
+	// call sees the latest slot change or the call after that change sees indexedFull
+	// out of step, so the last one leaves the resturant where it belongs.
+	void capacity_changed(Resturant& resturant){
+		if(resturant.isFull() == resturant.isIndexedFull()){
+			return;
+		}
+		lock_guard<mutex> menuLock(resturant.getMenuLock());
+		bool full = resturant.isFull();
+		while(full != resturant.isIndexedFull()){
+			resturant.setIndexedFull(full);
+			setOpen(resturant, !full);
+			full = resturant.isFull();
+		}
+	}
+
+	// visit(Resturant&) for every resturant itself, not a copy
+	template<typename Visit>
+	void forEachResturant(Visit visit){
+		for(auto &it : resturantMap){
+			visit(it.second);
+		}
+	}
+
+	vector<Resturant> getResturants(){
+		vector<Resturant> resVec;
+		for(auto &it : resturantMap){
+			resVec.push_back(it.second);
+		}
+		return resVec;
+	}
+
+	void clear(){
+		resturantMap.clear();
+		for(Shard &shard : shards){
+			unique_lock<shared_mutex> lock(shard.lock);
+			shard.allResturants.clear();
+			shard.openResturants.clear();
+		}
+	}
+};
+
+#endif
@@ -0,0 +1,301 @@
+#ifndef FOOD_ORDERING_STATE_STORE
+#define FOOD_ORDERING_STATE_STORE
+#include <iostream>
+#include <string>
+#include <vector>
+#include <deque>
+#include <map>
+#include <unordered_set>
+#include <utility>
+#include <mutex>
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "event_log.hpp"
+#include "resturant_map.hpp"
+#include "order_manager.hpp"
+
+using namespace std;
+
+// Keeps resturants, menus and orders across restarts in a directory. It holds the
+// latest snapshot and the log files written since then.
+// A snapshot is a compacted log: a header naming the first log generation to replay
+// after it, then one RESTURANT_ADDED record per resturant and one ORDER_PLACED per
+// order. At start the snapshot is mapped and the log tail is replayed on top of it, so
+// restart time follows the changes since the last snapshot, not the whole history.
+// A snapshot is taken while orders go on: the log is rotated first, so a change is in
+// the snapshot, in the newer log or in both. Replaying the events is idempotent, which
+// makes both fine.
+class StateStore{
+	static const uint32_t MAGIC = 0x4E534F46;		// "FOSN"
+	static const uint32_t VERSION = 1;
+	static const long long SNAPSHOT_AFTER = 4 << 20;	// log bytes
+
+	// a resturant as the snapshot and the log describe it, before it is rebuilt
+	struct RestoredResturant{
+		int rating = 0;
+		int maxLimit = 0;
+		Location location;
+		map<string, int> dishes;
+		vector<Order> current;
+		deque<Order> pending;
+	};
+
+	string directory;
+	ResturantMap resturantMap;
+	map<string, RestoredResturant> restored;
+	unordered_set<long long> knownOrders;		// orders in restored
+	long long nextOrderId;
+	long long firstGeneration;					// oldest log file still kept
+	mutex snapshotLock;
+
+	string snapshotPath(){
+		return directory + "/snapshot";
+	}
+
+	static void readDishes(EventReader& reader, map<string, int>& dishes){
+		long long count = reader.getInt();
+		for(long long i=0; i<count && reader.ok(); ++i){
+			string dishName = reader.getString();
+			dishes[dishName] = reader.getInt();
+		}
+	}
+
+	static Order readOrder(EventReader& reader, string& resName){
+		long long id = reader.getInt();
+		string userName = reader.getString();
+		string dishName = reader.getString();
+		resName = reader.getString();
+		OrderStatus status = (OrderStatus)reader.getInt();
+		long long createdAt = reader.getInt();
+		long long startedAt = reader.getInt();
+		Order order(id, userName, DishInterner::intern(dishName));
+		order.setStatus(status);
+		order.setTimes(createdAt, startedAt);
+		return order;
+	}
+
+	void forgetOrders(RestoredResturant& resturant){
+		for(Order &order : resturant.current)	knownOrders.erase(order.getId());
+		for(Order &order : resturant.pending)	knownOrders.erase(order.getId());
+	}
+
+	// one record of the snapshot or the log, a record seen twice changes nothing more
+	void apply(EventReader& reader){
+		int type = reader.getType();
+		if(type == ORDER_PLACED){
+			string resName;
+			Order order = readOrder(reader, resName);
+			auto it = restored.find(resName);
+			if(!reader.ok() || it == restored.end() || knownOrders.count(order.getId()))	return;
+			knownOrders.insert(order.getId());
+			nextOrderId = max(nextOrderId, order.getId() + 1);
+			if(order.getStatus() == PLACED){
+				it->second.current.push_back(order);
+			}else{
+				it->second.pending.push_back(order);
+			}
+			return;
+		}
+		string resName = reader.getString();
+		if(type == RESTURANT_ADDED){
+			RestoredResturant resturant;
+			resturant.rating = reader.getInt();
+			resturant.maxLimit = reader.getInt();
+			resturant.location.x = reader.getDouble();
+			resturant.location.y = reader.getDouble();
+			readDishes(reader, resturant.dishes);
+			if(!reader.ok())	return;
+			auto it = restored.find(resName);
+			if(it != restored.end())	forgetOrders(it->second);
+			restored[resName] = resturant;
+			return;
+		}
+		auto it = restored.find(resName);
+		if(it == restored.end())	return;
+		RestoredResturant& resturant = it->second;
+		if(type == MENU_CHANGED){
+			map<string, int> dishes;
+			readDishes(reader, dishes);
+			if(!reader.ok())	return;
+			for(auto &dish : dishes)	resturant.dishes[dish.first] = dish.second;
+		}else if(type == RATING_CHANGED){
+			int rating = reader.getInt();
+			if(reader.ok())	resturant.rating = rating;
+		}else if(type == LOCATION_CHANGED){
+			Location location;
+			location.x = reader.getDouble();
+			location.y = reader.getDouble();
+			if(reader.ok())	resturant.location = location;
+		}else if(type == ORDER_COMPLETED){
+			long long orderId = reader.getInt();
+			long long promotedId = reader.getInt();
+			long long promotedStart = reader.getInt();
+			if(!reader.ok())	return;
+			for(size_t i=0; i<resturant.current.size(); ++i){
+				if(resturant.current[i].getId() == orderId){
+					resturant.current.erase(resturant.current.begin() + i);
+					knownOrders.erase(orderId);
+					break;
+				}
+			}
+			for(size_t i=0; promotedId != 0 && i<resturant.pending.size(); ++i){
+				Order& order = resturant.pending[i];
+				if(order.getId() == promotedId){
+					order.setStatus(PLACED);
+					order.setTimes(order.getCreatedAt(), promotedStart);
+					resturant.current.push_back(order);
+					resturant.pending.erase(resturant.pending.begin() + i);
+					break;
+				}
+			}
+		}
+	}
+
+	// puts what was read into the ResturantMap and the resturants
+	void rebuild(){
+		resturantMap.clear();
+		for(auto &it : restored){
+			RestoredResturant& from = it.second;
+			Resturant resturant(it.first, from.rating, from.maxLimit, from.location);
+			vector<pair<int, int>> dishes;
+			for(auto &dish : from.dishes)	dishes.push_back(make_pair(DishInterner::intern(dish.first), dish.second));
+			resturant.update_menu(dishes);
+			resturantMap.add_resturant(resturant);
+			Resturant* added = resturantMap.find_resturant(it.first);
+			for(Order &order : from.current)	added->restoreOrder(order);
+			for(Order &order : from.pending)	added->restoreOrder(order);
+			resturantMap.capacity_changed(*added);
+		}
+		OrderManager::resume_order_ids(nextOrderId);
+		restored.clear();
+		knownOrders.clear();
+	}
+
+	bool writeFile(const string& path, const string& bytes){
+		int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+		if(fd < 0)	return false;
+		size_t done = 0;
+		while(done < bytes.size()){
+			ssize_t written = ::write(fd, bytes.data() + done, bytes.size() - done);
+			if(written < 0){
+				::close(fd);
+				return false;
+			}
+			done += written;
+		}
+		bool synced = fsync(fd) == 0;
+		::close(fd);
+		return synced;
+	}
+
+	void syncDirectory(){
+		int fd = ::open(directory.c_str(), O_RDONLY);
+		if(fd < 0)	return;
+		fsync(fd);
+		::close(fd);
+	}
+
+public:
+	StateStore(string directory){
+		this->directory = directory;
+		this->nextOrderId = 1;
+		this->firstGeneration = 0;
+	}
+
+	// Rebuilds the resturants from the snapshot and the logs after it, then logs every
+	// change from here on into a new log file. Returns the number of resturants.
+	// Must run before any order is placed.
+	int recover(){
+		mkdir(directory.c_str(), 0755);
+		long long generation = 0;
+		{
+			MappedFile snapshot(snapshotPath());
+			size_t headerSize = 2 * sizeof(uint32_t) + 2 * sizeof(long long);
+			if(snapshot.getSize() >= headerSize){
+				uint32_t header[2];
+				long long fields[2];
+				memcpy(header, snapshot.getData(), sizeof(header));
+				memcpy(fields, snapshot.getData() + sizeof(header), sizeof(fields));
+				if(header[0] == MAGIC && header[1] == VERSION){
+					generation = fields[0];
+					nextOrderId = max(nextOrderId, fields[1]);
+					EventLog::forEachRecord(snapshot.getData() + headerSize, snapshot.getSize() - headerSize,
+											[&](EventReader& reader){ apply(reader); });
+				}else{
+					cout << "WARNING: " << snapshotPath() << " is not a snapshot, it is ignored" << endl;
+				}
+			}
+		}
+		firstGeneration = generation;
+		while(EventLog::replay(directory, generation, [&](EventReader& reader){ apply(reader); })){
+			generation++;
+		}
+		int count = restored.size();
+		rebuild();
+		EventLog::open(directory, generation);
+		return count;
+	}
+
+	// Writes every resturant and order into a new snapshot and drops the log files it
+	// covers. May run while orders are placed, not together with add_resturant.
+	bool snapshot(){
+		lock_guard<mutex> held(snapshotLock);
+		long long generation = EventLog::rotate();
+		string bytes;
+		uint32_t header[2] = {MAGIC, VERSION};
+		long long fields[2] = {generation, OrderManager::next_order_id()};
+		bytes.append((const char*)header, sizeof(header));
+		bytes.append((const char*)fields, sizeof(fields));
+		vector<Order> orders;
+		resturantMap.forEachResturant([&](Resturant& resturant){
+			vector<pair<string, int>> dishes;
+			EventRecord record(RESTURANT_ADDED);
+			{
+				lock_guard<mutex> menuLock(resturant.getMenuLock());
+				resturant.getMenu().forEachDish([&](int dishId, int price){
+					dishes.push_back(make_pair(DishInterner::name(dishId), price));
+				});
+				Location location = resturant.getLocation();
+				record.putString(resturant.getName()).putInt(resturant.getRating()).putInt(resturant.getMaxLimit());
+				record.putDouble(location.x).putDouble(location.y);
+			}
+			record.putInt(dishes.size());
+			for(auto &dish : dishes)	record.putString(dish.first).putInt(dish.second);
+			EventLog::frame(record, bytes);
+			orders.clear();
+			resturant.forEachOrder([&](const Order& order){ orders.push_back(order); });
+			for(Order &order : orders){
+				EventRecord placed(ORDER_PLACED);
+				EventLog::putOrder(placed, order);
+				EventLog::frame(placed, bytes);
+			}
+		});
+		string temporary = snapshotPath() + ".tmp";
+		if(!writeFile(temporary, bytes) || rename(temporary.c_str(), snapshotPath().c_str()) != 0){
+			cout << "WARNING: Snapshot could not be written, the logs are kept" << endl;
+			return false;
+		}
+		syncDirectory();
+		for(; firstGeneration<generation; ++firstGeneration){
+			remove(EventLog::path_of(directory, firstGeneration).c_str());
+		}
+		return true;
+	}
+
+	// a snapshot once the current log file has grown past SNAPSHOT_AFTER bytes
+	void snapshotIfLarge(){
+		if(EventLog::isOpen() && EventLog::size() > SNAPSHOT_AFTER){
+			snapshot();
+		}
+	}
+
+	void close(){
+		EventLog::close();
+	}
+};
+
+#endif
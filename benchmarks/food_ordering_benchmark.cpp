@@ -0,0 +1,269 @@
+// Google Benchmark suite for the food ordering system: placing orders, editing menus and ratings
+#include <benchmark/benchmark.h>
+#include <string>
+#include "order_manager.hpp"
+#include "order_pipeline.hpp"
+#include "state_store.hpp"
+
+using namespace std;
+
+static void fillResturants(int numResturants){
+    ResturantMap resturantMap;
+    resturantMap.clear();
+    for(int i=0; i<numResturants; ++i){
+        Resturant resturant("R" + to_string(i), i * 7 % 5 + 1, 10);
+        resturant.add_to_menu("Dosa", 50 + i * 13 % 97);
+        resturant.add_to_menu("Idli", 30 + i * 11 % 89);
+        resturantMap.add_resturant(resturant);
+    }
+}
+
+// One iteration places an order and completes it again
+static void BM_PlaceAndCompleteOrder(benchmark::State& state){
+    if(state.thread_index() == 0)   fillResturants(state.range(0));
+    string selection = state.range(1) == 0 ? "RATING" : "LOWEST";
+    OrderManager orderManager;
+    Order promoted;
+    for(auto _ : state){
+        Order order = orderManager.place_order("user", "Dosa", selection);
+        benchmark::DoNotOptimize(orderManager.complete_order(order, promoted));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(selection);
+    if(state.thread_index() == 0)   ResturantMap().clear();
+}
+BENCHMARK(BM_PlaceAndCompleteOrder)->Args({100, 0})->Args({100, 1})->Args({10000, 0})->Args({10000, 1});
+BENCHMARK(BM_PlaceAndCompleteOrder)->Args({10000, 1})->ThreadRange(2, 8)->UseRealTime();
+
+// The same with every change in the EventLog, each order waits for its records to be
+// on disk. Threads that wait together share one fsync.
+static void BM_LoggedPlaceAndCompleteOrder(benchmark::State& state){
+    static string directory;
+    if(state.thread_index() == 0){
+        char name[] = "/tmp/food_ordering_logXXXXXX";
+        directory = mkdtemp(name);
+        fillResturants(state.range(0));
+        EventLog::open(directory, 0);
+    }
+    OrderManager orderManager;
+    Order promoted;
+    for(auto _ : state){
+        Order order = orderManager.place_order("user", "Dosa", "LOWEST");
+        benchmark::DoNotOptimize(orderManager.complete_order(order, promoted));
+    }
+    state.SetItemsProcessed(state.iterations());
+    if(state.thread_index() == 0){
+        EventLog::close();
+        remove(EventLog::path_of(directory, 0).c_str());
+        rmdir(directory.c_str());
+        ResturantMap().clear();
+    }
+}
+BENCHMARK(BM_LoggedPlaceAndCompleteOrder)->Arg(10000)->ThreadRange(1, 8)->UseRealTime();
+
+// A corporate order of batchSize orders, mostly Dosa, placed one by one or as one
+// batch, then completed again
+static void BM_PlaceOrders(benchmark::State& state){
+    fillResturants(10000);
+    int batchSize = state.range(0);
+    bool batch = state.range(1) == 1;
+    OrderManager orderManager;
+    vector<OrderRequest> requests;
+    for(int i=0; i<batchSize; ++i){
+        requests.push_back(OrderRequest{"user" + to_string(i), i % 5 ? "Dosa" : "Idli", i % 3 ? "RATING" : "LOWEST"});
+    }
+    vector<Order> orders;
+    Order promoted;
+    for(auto _ : state){
+        if(batch){
+            orders = orderManager.place_order_batch(requests);
+        }else{
+            orders.clear();
+            for(OrderRequest &request : requests){
+                orders.push_back(orderManager.place_order(request.userName, request.dishName, request.selection));
+            }
+        }
+        state.PauseTiming();
+        for(Order &order : orders)  orderManager.complete_order(order, promoted);
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * batchSize);
+    state.SetLabel(batch ? "place_order_batch" : "place_order");
+    ResturantMap().clear();
+}
+BENCHMARK(BM_PlaceOrders)->Args({500, 0})->Args({500, 1});
+
+// Orders through the staged pipeline, 2 selection and 2 reservation threads.
+// The kitchen finishes every order as soon as it is confirmed.
+static void BM_OrderPipeline(benchmark::State& state){
+    fillResturants(state.range(0));
+    OrderManager kitchen;
+    Order promoted;
+    OrderPipeline pipeline(2, 2, 4096, [&](Order& order){
+        if(order.getStatus() == PLACED) kitchen.complete_order(order, promoted);
+    });
+    const int batch = 10000;
+    for(auto _ : state){
+        for(int i=0; i<batch; ++i){
+            pipeline.submit("user", i % 2 ? "Dosa" : "Idli", i % 3 ? "LOWEST" : "RATING");
+        }
+        pipeline.drain();
+    }
+    pipeline.stop();
+    state.SetItemsProcessed(state.iterations() * batch);
+    ResturantMap().clear();
+}
+BENCHMARK(BM_OrderPipeline)->Arg(10000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Every resturant is full and some orders wait, each iteration places one more
+// order and completes the oldest one being prepared, which promotes a waiting order
+static void BM_PendingPromotion(benchmark::State& state){
+    fillResturants(state.range(0));
+    OrderManager orderManager;
+    vector<Order> preparing(1 << 16);      // ring of the orders holding a slot
+    size_t first = 0, last = 0, mask = preparing.size() - 1;
+    for(int i=0; i<state.range(0) * 11; ++i){
+        Order order = orderManager.place_order("user", "Dosa", "LOWEST");
+        if(order.getStatus() == PLACED) preparing[last++ & mask] = order;
+    }
+    Order promoted;
+    for(auto _ : state){
+        Order order = orderManager.place_order("user", "Dosa", "LOWEST");
+        if(order.getStatus() == PLACED) preparing[last++ & mask] = order;
+        orderManager.complete_order(preparing[first++ & mask], promoted);
+        if(promoted.getId() != 0)   preparing[last++ & mask] = promoted;
+    }
+    state.SetItemsProcessed(state.iterations());
+    ResturantMap().clear();
+}
+BENCHMARK(BM_PendingPromotion)->Arg(100);
+
+// Top 5 by rating within radius km among numResturants resturants spread over a
+// 50 x 50 km city, only the ones serving Dosa with free capacity
+static void BM_NearbyResturants(benchmark::State& state){
+    int numResturants = state.range(0);
+    double radius = state.range(1);
+    ResturantMap resturantMap;
+    resturantMap.clear();
+    for(int i=0; i<numResturants; ++i){
+        Location location((i * 7919 % 50000) / 1000.0, (i * 104729 % 50000) / 1000.0);
+        Resturant resturant("R" + to_string(i), i * 7 % 5 + 1, 10, location);
+        resturant.add_to_menu(i % 2 ? "Dosa" : "Idli", 50 + i * 13 % 97);
+        resturantMap.add_resturant(resturant);
+    }
+    int dosa = DishInterner::find("Dosa");
+    int i = 0;
+    for(auto _ : state){
+        Location customer((i * 37 % 50), (i * 53 % 50));
+        benchmark::DoNotOptimize(resturantMap.nearby_resturants(dosa, customer, radius, 5, true));
+        i++;
+    }
+    state.SetItemsProcessed(state.iterations());
+    resturantMap.clear();
+}
+BENCHMARK(BM_NearbyResturants)->Args({100000, 2})->Args({100000, 10});
+
+// Moves one resturant's Dosa price up and down among the others, the index follows every change
+static void BM_UpdateInMenu(benchmark::State& state){
+    fillResturants(state.range(0));
+    ResturantMap resturantMap;
+    int price = 0;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(resturantMap.update_in_menu("R0", "Dosa", 40 + price++ % 120));
+    }
+    state.SetItemsProcessed(state.iterations());
+    resturantMap.clear();
+}
+BENCHMARK(BM_UpdateInMenu)->Arg(10000);
+
+static void BM_UpdateRating(benchmark::State& state){
+    fillResturants(state.range(0));
+    ResturantMap resturantMap;
+    int rating = 0;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(resturantMap.update_rating("R0", 1 + rating++ % 5));
+    }
+    state.SetItemsProcessed(state.iterations());
+    resturantMap.clear();
+}
+BENCHMARK(BM_UpdateRating)->Arg(10000);
+
+// Reprices every dish of a resturant with numDishes dishes, one update_in_menu per
+// dish or one update_menu for all of them
+static void BM_MenuRefresh(benchmark::State& state){
+    int numDishes = state.range(0);
+    bool bulk = state.range(1) == 1;
+    ResturantMap resturantMap;
+    resturantMap.add_resturant(Resturant("R", 5, 10));
+    vector<pair<string, int>> changes;
+    for(int i=0; i<numDishes; ++i)  changes.push_back(make_pair("dish" + to_string(i), i));
+    resturantMap.update_menu("R", changes);
+    int round = 0;
+    for(auto _ : state){
+        round++;
+        for(auto &change : changes) change.second = round + change.second % 1000;
+        if(bulk){
+            resturantMap.update_menu("R", changes);
+        }else{
+            for(auto &change : changes) resturantMap.update_in_menu("R", change.first, change.second);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numDishes);
+    state.SetLabel(bulk ? "update_menu" : "update_in_menu");
+    resturantMap.clear();
+}
+BENCHMARK(BM_MenuRefresh)->Args({1000, 0})->Args({1000, 1});
+
+// Adds numDishes new dishes to one menu
+static void BM_AddToMenu(benchmark::State& state){
+    int numDishes = state.range(0);
+    vector<string> dishes;
+    for(int i=0; i<numDishes; ++i)  dishes.push_back("dish" + to_string(i));
+    for(auto _ : state){
+        Resturant resturant("R", 5, 10);
+        for(int i=0; i<numDishes; ++i){
+            benchmark::DoNotOptimize(resturant.add_to_menu(dishes[i], i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * numDishes);
+}
+BENCHMARK(BM_AddToMenu)->Arg(1000);
+
+// Price lookups on a menu of numDishes dishes, by name (interned at the call) or by id
+static void BM_MenuGetPrice(benchmark::State& state){
+    int numDishes = state.range(0);
+    bool byId = state.range(1) == 1;
+    Menu menu;
+    vector<string> dishes;
+    vector<int> ids;
+    for(int i=0; i<numDishes; ++i){
+        dishes.push_back("dish" + to_string(i));
+        menu.addToMenu(dishes.back(), i);
+        ids.push_back(DishInterner::find(dishes.back()));
+    }
+    int i = 0;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(byId ? menu.getPrice(ids[i]) : menu.getPrice(dishes[i]));
+        i = i + 1 == numDishes ? 0 : i + 1;
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(byId ? "by id" : "by name");
+}
+BENCHMARK(BM_MenuGetPrice)->Args({1000, 0})->Args({1000, 1});
+
+// Cost of the instrumentation itself, empty with -DLLD_METRICS=OFF
+static void BM_MetricsCount(benchmark::State& state){
+    for(auto _ : state){
+        Metrics::count(ORDERS_PLACED);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_MetricsCount);
+
+static void BM_StageTimer(benchmark::State& state){
+    for(auto _ : state){
+        StageTimer timer(SELECT);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_StageTimer);
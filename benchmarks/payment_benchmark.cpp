@@ -0,0 +1,159 @@
+// Google Benchmark suite for the payment Strategy example
+#include <benchmark/benchmark.h>
+#include <streambuf>
+#include <vector>
+#include <future>
+#include <thread>
+#include <chrono>
+#include "paymentSystem.hpp"
+#include "paymentEngine.hpp"
+#include "idempotencyCache.hpp"
+
+using namespace std;
+
+class NullOutput : public streambuf{
+protected:
+    int overflow(int c) override{
+        return c;
+    }
+};
+
+static void BM_ProcessPayment(benchmark::State& state){
+    UPIPayment upi;
+    NEFTPayment neft;
+    IPayment* mode = state.range(0) == 0 ? (IPayment*)&upi : (IPayment*)&neft;
+    int amount = 0;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(mode->processPayment(amount++));
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(state.range(0) == 0 ? "upi" : "neft");
+}
+BENCHMARK(BM_ProcessPayment)->Arg(0)->Arg(1);
+
+// The whole PaymentSystem::makePayment with the receipt written to a null stream
+static void BM_MakePayment(benchmark::State& state){
+    PaymentSystem system;
+    string mode = state.range(0) == 0 ? "upi" : "neft";
+    NullOutput nullOutput;
+    streambuf* oldOut = cout.rdbuf(&nullOutput);
+    int amount = 0;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(system.makePayment(mode, amount++));
+    }
+    cout.rdbuf(oldOut);
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(mode);
+}
+BENCHMARK(BM_MakePayment)->Arg(0)->Arg(1);
+
+// Dispatch by mode id, the receipt formatted into a caller buffer (Arg 1) or not at all
+static void BM_MakePaymentByMode(benchmark::State& state){
+    PaymentSystem system;
+    bool receipt = state.range(0) == 1;
+    char buffer[64];
+    int amount = 0;
+    for(auto _ : state){
+        PaymentResult result = system.makePayment((PaymentMode)(amount & 1), amount);
+        amount++;
+        if(receipt) result.format(buffer, sizeof(buffer));
+        benchmark::DoNotOptimize(result);
+        benchmark::DoNotOptimize(buffer);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(receipt ? "with receipt" : "result only");
+}
+BENCHMARK(BM_MakePaymentByMode)->Arg(0)->Arg(1);
+
+// A gateway that takes 2ms per call, for one payment or a whole batch
+class SlowGateway : public IPayment{
+private:
+    PaymentResult makePayment(int amount){
+        this_thread::sleep_for(chrono::milliseconds(2));
+        return PaymentResult{true, NEFT, amount};
+    }
+
+    void makePayments(const int* amounts, size_t count, PaymentResult* results){
+        this_thread::sleep_for(chrono::milliseconds(2));
+        for(size_t i=0; i<count; ++i)   results[i] = PaymentResult{true, NEFT, amounts[i]};
+    }
+};
+
+// 64 payments against the slow gateway: one after another (Arg 0), through the engine
+// with 8 in flight (Arg 1), or batched 32 per call (Arg 2)
+static void BM_SlowGatewayPayments(benchmark::State& state){
+    const int payments = 64;
+    SlowGateway gateway;
+    PaymentEngine engine;
+    GatewayOptions options;
+    options.maxInFlight = 8;
+    if(state.range(0) == 2){
+        options.maxInFlight = 2;
+        options.batchSize = 32;
+        options.batchWait = chrono::milliseconds(1);
+    }
+    if(state.range(0) != 0) engine.addGateway(NEFT, &gateway, options);
+    vector<future<PaymentResult>> results;
+    for(auto _ : state){
+        if(state.range(0) == 0){
+            for(int i=0; i<payments; ++i)   benchmark::DoNotOptimize(gateway.processPayment(i));
+            continue;
+        }
+        results.clear();
+        for(int i=0; i<payments; ++i)   results.push_back(engine.submit(NEFT, i));
+        for(auto &result : results) benchmark::DoNotOptimize(result.get());
+    }
+    state.SetItemsProcessed(state.iterations() * payments);
+    state.SetLabel(state.range(0) == 0 ? "synchronous" : state.range(0) == 1 ? "engine" : "engine, batched");
+}
+BENCHMARK(BM_SlowGatewayPayments)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// A repeated submission answered from the idempotency cache, 100k ids remembered
+static void BM_IdempotentRepeat(benchmark::State& state){
+    static IdempotencyCache cache(1 << 20, chrono::hours(1));
+    static vector<string> ids;
+    UPIPayment upi;
+    if(state.thread_index() == 0 && ids.empty()){
+        for(int i=0; i<100000; ++i){
+            ids.push_back("payment-" + to_string(i));
+            cache.run(ids.back(), [&]{ return upi.processPayment(i); });
+        }
+    }
+    size_t next = state.thread_index() * 7919;
+    bool cached = false;
+    for(auto _ : state){
+        const string& id = ids[next++ % ids.size()];
+        benchmark::DoNotOptimize(cache.run(id, [&]{ return upi.processPayment(0); }, &cached));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IdempotentRepeat)->ThreadRange(1, 4)->UseRealTime();
+
+// First submissions, every id is new and the oldest are dropped past the capacity
+static void BM_IdempotentFirst(benchmark::State& state){
+    IdempotencyCache cache(1 << 16, chrono::hours(1));
+    UPIPayment upi;
+    long long next = 0;
+    string id;
+    for(auto _ : state){
+        id = "payment-" + to_string(next++);
+        benchmark::DoNotOptimize(cache.run(id, [&]{ return upi.processPayment(1); }));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_IdempotentFirst);
+
+static void BM_IdempotencySnapshot(benchmark::State& state){
+    IdempotencyCache cache(1 << 20, chrono::hours(1));
+    UPIPayment upi;
+    for(int i=0; i<state.range(0); ++i) cache.run("payment-" + to_string(i), [&]{ return upi.processPayment(i); });
+    string path = "/tmp/payment_benchmark_idempotency";
+    for(auto _ : state){
+        cache.snapshot(path);
+        IdempotencyCache restored(1 << 20, chrono::hours(1));
+        benchmark::DoNotOptimize(restored.load(path));
+    }
+    remove(path.c_str());
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_IdempotencySnapshot)->Arg(100000)->Unit(benchmark::kMillisecond);
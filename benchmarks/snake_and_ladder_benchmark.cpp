@@ -0,0 +1,73 @@
+// Google Benchmark suite for Snake and Ladder: one move on the board, whole games and dice rolls
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "lockstep_simulator.hpp"
+
+using namespace std;
+
+static int jumps[][2] = {{1, 38}, {4, 14}, {9, 31}, {21, 42}, {28, 84}, {36, 44}, {51, 67}, {71, 91}, {80, 100},
+                         {16, 6}, {47, 26}, {49, 11}, {56, 53}, {62, 19}, {64, 60}, {87, 24}, {93, 73}, {95, 75}, {98, 78}};
+
+static Board classicBoard(){
+    Board board(100);
+    for(auto &jump : jumps){
+        board.addJump(jump[0], jump[1]);
+    }
+    return board;
+}
+
+static void BM_BoardMoveToPos(benchmark::State& state){
+    Board board = classicBoard();
+    int position = 1;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(board.moveToPos(position));
+        position = position == 100 ? 1 : position + 1;
+    }
+}
+BENCHMARK(BM_BoardMoveToPos);
+
+static void BM_CompiledBoardMove(benchmark::State& state){
+    Board board = classicBoard();
+    CompiledBoard compiled(board, 6);
+    int position = 0, roll = 1;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(compiled.move(position, roll));
+        roll = roll == 6 ? 1 : roll + 1;
+        position = position == 99 ? 0 : position + 1;
+    }
+}
+BENCHMARK(BM_CompiledBoardMove);
+
+// Two player games on the classic board, single thread
+static void BM_LockstepGames(benchmark::State& state){
+    Board board = classicBoard();
+    LockstepSimulator simulator(board, Dice(1), 2, 1);
+    long long numGames = state.range(0);
+    for(auto _ : state){
+        SimulationResult result = simulator.run(numGames);
+        benchmark::DoNotOptimize(result.games);
+    }
+    state.SetItemsProcessed(state.iterations() * numGames);
+    state.SetLabel(LockstepSimulator::instructionSet());
+}
+BENCHMARK(BM_LockstepGames)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_ThrowDice(benchmark::State& state){
+    Dice dice(1, 6, 42);
+    for(auto _ : state){
+        benchmark::DoNotOptimize(dice.throwDice());
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_ThrowDice);
+
+static void BM_ThrowMany(benchmark::State& state){
+    Dice dice(1, 6, 42);
+    vector<int> rolls(state.range(0));
+    for(auto _ : state){
+        dice.throwMany(rolls);
+        benchmark::DoNotOptimize(rolls.data());
+    }
+    state.SetItemsProcessed(state.iterations() * rolls.size());
+}
+BENCHMARK(BM_ThrowMany)->Arg(4096);
@@ -0,0 +1,153 @@
+// Google Benchmark suite for the SOLID examples: invoice saves straight into a backend
+// or through the BufferedInvoiceDao, month end invoicing one by one or in the
+// InvoicePipeline, and the MacBook wired with make_shared or by a Container
+#include <benchmark/benchmark.h>
+#include <string>
+#include <cstdio>
+#include <memory>
+#include <vector>
+#include "invoice_dao.hpp"
+#include "invoice_pipeline.hpp"
+#include "macbook.hpp"
+#include "di_container.hpp"
+
+using namespace std;
+
+static const char* BENCHMARK_FILE = "/tmp/solid_benchmark_invoices.csv";
+
+// Arg 0 saves straight into the file, Arg 1 through the buffer, flushed at the end
+static void BM_FileInvoiceSave(benchmark::State& state){
+    remove(BENCHMARK_FILE);
+    FileInvoiceDao file(BENCHMARK_FILE);
+    unique_ptr<BufferedInvoiceDao> buffered;
+    if(state.range(0) == 1) buffered.reset(new BufferedInvoiceDao(&file, 512));
+    InvoiceDao* dao = buffered ? (InvoiceDao*)buffered.get() : (InvoiceDao*)&file;
+    Invoice invoice(0, "customer", Marker(1, "Camlin"), 3);
+    for(auto _ : state){
+        invoice.id++;
+        dao->save(&invoice);
+    }
+    if(buffered) buffered->flush();
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(state.range(0) == 0 ? "direct" : "buffered");
+    remove(BENCHMARK_FILE);
+}
+BENCHMARK(BM_FileInvoiceSave)->Arg(0)->Arg(1)->UseRealTime();
+
+// A database with a 50us round trip per call
+static void BM_DatabaseInvoiceSave(benchmark::State& state){
+    Database database(chrono::microseconds(50));
+    unique_ptr<BufferedInvoiceDao> buffered;
+    if(state.range(0) == 1) buffered.reset(new BufferedInvoiceDao(&database, 512));
+    InvoiceDao* dao = buffered ? (InvoiceDao*)buffered.get() : (InvoiceDao*)&database;
+    Invoice invoice(0, "customer", Marker(1, "Camlin"), 3);
+    for(auto _ : state){
+        invoice.id++;
+        dao->save(&invoice);
+    }
+    if(buffered) buffered->flush();
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(state.range(0) == 0 ? "direct" : "buffered");
+}
+BENCHMARK(BM_DatabaseInvoiceSave)->Arg(0)->Arg(1)->UseRealTime();
+
+// 20k invoices billed, printed and saved into a database with a 20us round trip:
+// one after another on one thread (Arg 0), or in the pipeline with Arg threads a stage
+static void BM_MonthEndInvoices(benchmark::State& state){
+    const int invoices = 20000;
+    Database database(chrono::microseconds(20));
+    for(auto _ : state){
+        if(state.range(0) == 0){
+            InvoiceBill bill;
+            InvoicePrint print;
+            string text;
+            for(int i=0; i<invoices; ++i){
+                Invoice invoice(i, "customer", Marker(i % 5, "Camlin"), 1 + i % 12);
+                bill.generateBill(invoice);
+                text.clear();
+                print.printInvoice(invoice, text);
+                database.save(&invoice);
+            }
+            continue;
+        }
+        PipelineOptions options;
+        options.billThreads = options.printThreads = options.saveThreads = state.range(0);
+        InvoicePipeline pipeline(&database, options);
+        for(int i=0; i<invoices; ++i)   pipeline.submit(Invoice(i, "customer", Marker(i % 5, "Camlin"), 1 + i % 12));
+        pipeline.stop();
+    }
+    state.SetItemsProcessed(state.iterations() * invoices);
+    state.SetLabel(state.range(0) == 0 ? "one by one" : "pipeline");
+}
+BENCHMARK(BM_MonthEndInvoices)->Arg(0)->Arg(1)->Arg(2)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static const char* WIRING_NAMES[] = {"make_shared", "Container<SingleThreaded>", "Container<MultiThreaded>"};
+
+// 1000 MacBooks sharing one keyboard and one mouse, wired and dropped again
+template<typename Policy>
+static void wireWithContainer(vector<Ref<WiredMacBook<Policy>, Policy>>& macBooks){
+    Container<Policy> container;
+    container.template bind<IKeyboard, MechanicalKeyboard>();
+    container.template bind<IMouse, OpticalMouse>();
+    Ref<IKeyboard, Policy> keyboard = container.template get<IKeyboard>();
+    Ref<IMouse, Policy> mouse = container.template get<IMouse>();
+    for(int i=0; i<1000; ++i){
+        macBooks.push_back(container.template make<WiredMacBook<Policy>>(keyboard, mouse));
+    }
+    benchmark::DoNotOptimize(macBooks.back()->use());
+    macBooks.clear();
+}
+
+static void BM_WireMacBooks(benchmark::State& state){
+    vector<shared_ptr<MacBook>> shared;
+    vector<Ref<WiredMacBook<SingleThreaded>, SingleThreaded>> single;
+    vector<Ref<WiredMacBook<MultiThreaded>, MultiThreaded>> multi;
+    shared.reserve(1000);
+    single.reserve(1000);
+    multi.reserve(1000);
+    for(auto _ : state){
+        if(state.range(0) == 0){
+            shared_ptr<IKeyboard> keyboard = make_shared<MechanicalKeyboard>();
+            shared_ptr<IMouse> mouse = make_shared<OpticalMouse>();
+            for(int i=0; i<1000; ++i)   shared.push_back(make_shared<MacBook>(keyboard, mouse));
+            benchmark::DoNotOptimize(shared.back()->use());
+            shared.clear();
+        }else if(state.range(0) == 1){
+            wireWithContainer<SingleThreaded>(single);
+        }else{
+            wireWithContainer<MultiThreaded>(multi);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * 1000);
+    state.SetLabel(WIRING_NAMES[state.range(0)]);
+}
+BENCHMARK(BM_WireMacBooks)->Arg(0)->Arg(1)->Arg(2);
+
+// passing a MacBook handle around: one copy and one drop
+template<typename Handle>
+static void copyHandles(benchmark::State& state, Handle& handle){
+    for(auto _ : state){
+        Handle copy = handle;
+        benchmark::DoNotOptimize(copy);
+    }
+}
+
+static void BM_CopyMacBookHandle(benchmark::State& state){
+    shared_ptr<IKeyboard> keyboard = make_shared<MechanicalKeyboard>();
+    shared_ptr<IMouse> mouse = make_shared<OpticalMouse>();
+    shared_ptr<MacBook> shared = make_shared<MacBook>(keyboard, mouse);
+    Container<SingleThreaded> singleContainer;
+    singleContainer.bind<IKeyboard, MechanicalKeyboard>();
+    singleContainer.bind<IMouse, OpticalMouse>();
+    auto single = singleContainer.make<WiredMacBook<SingleThreaded>>(singleContainer.get<IKeyboard>(), singleContainer.get<IMouse>());
+    Container<MultiThreaded> multiContainer;
+    multiContainer.bind<IKeyboard, MechanicalKeyboard>();
+    multiContainer.bind<IMouse, OpticalMouse>();
+    auto multi = multiContainer.make<WiredMacBook<MultiThreaded>>(multiContainer.get<IKeyboard>(), multiContainer.get<IMouse>());
+    if(state.range(0) == 0) copyHandles(state, shared);
+    else if(state.range(0) == 1)    copyHandles(state, single);
+    else    copyHandles(state, multi);
+    state.SetItemsProcessed(state.iterations());
+    state.SetLabel(WIRING_NAMES[state.range(0)]);
+}
+BENCHMARK(BM_CopyMacBookHandle)->Arg(0)->Arg(1)->Arg(2);
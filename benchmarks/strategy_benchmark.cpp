@@ -0,0 +1,272 @@
+// Google Benchmark suite for the Strategy pattern example: one attack through the strategy
+// pointer (Player) or through the variant (VariantPlayer), waves of attacks, and a
+// population of players as objects or as a PlayerWorld, and strategy changes under
+// concurrent attacks
+#include <benchmark/benchmark.h>
+#include <vector>
+#include <memory>
+#include <random>
+#include <algorithm>
+#include <mutex>
+#include "player.hpp"
+#include "variant_player.hpp"
+#include "player_world.hpp"
+#include "concurrent_player.hpp"
+
+static void BM_PlayMeeleAttack(benchmark::State& state){
+    level1strategy level1;
+    level2strategy level2;
+    level3strategy level3;
+    strategyI* strategies[] = {&level1, &level2, &level3};
+    Player player;
+    player.setStrategy(strategies[state.range(0)]);
+    int a = 1, b = 2;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(a = player.playMeeleAttack(a & 1023, b));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PlayMeeleAttack)->Arg(0)->Arg(2);
+
+static void BM_PlayRangeAttack(benchmark::State& state){
+    level2strategy level2;
+    Player player;
+    player.setStrategy(&level2);
+    int a = 1, b = 2;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(a = player.playRangeAttack(a & 1023, b));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PlayRangeAttack);
+
+static void BM_VariantPlayMeeleAttack(benchmark::State& state){
+    levelStrategy strategies[] = {level1strategy(), level2strategy(), level3strategy()};
+    VariantPlayer player;
+    player.setStrategy(strategies[state.range(0)]);
+    int a = 1, b = 2;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(a = player.playMeeleAttack(a & 1023, b));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VariantPlayMeeleAttack)->Arg(0)->Arg(2);
+
+static void BM_VariantPlayRangeAttack(benchmark::State& state){
+    VariantPlayer player;
+    player.setStrategy(level2strategy());
+    int a = 1, b = 2;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(a = player.playRangeAttack(a & 1023, b));
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_VariantPlayRangeAttack);
+
+// 64 attacks per level, then the next level, the way a fight moves between levels
+static void BM_SwitchingStrategy(benchmark::State& state){
+    bool variant = state.range(0) == 1;
+    level1strategy level1;
+    level2strategy level2;
+    level3strategy level3;
+    strategyI* strategies[] = {&level1, &level2, &level3};
+    levelStrategy levels[] = {level1, level2, level3};
+    Player player;
+    VariantPlayer variantPlayer;
+    int a = 1, b = 2, level = 0;
+    for(auto _ : state){
+        level = level == 2 ? 0 : level + 1;
+        if(variant){
+            variantPlayer.setStrategy(levels[level]);
+            for(int i=0; i<64; ++i) a = variantPlayer.playMeeleAttack(a & 1023, b);
+        }else{
+            player.setStrategy(strategies[level]);
+            for(int i=0; i<64; ++i) a = player.playMeeleAttack(a & 1023, b);
+        }
+        benchmark::DoNotOptimize(a);
+    }
+    state.SetItemsProcessed(state.iterations() * 64);
+    state.SetLabel(variant ? "VariantPlayer" : "Player");
+}
+BENCHMARK(BM_SwitchingStrategy)->Arg(0)->Arg(1);
+
+// a wave of 1024 attacks: one call per attack, or one batch call (Arg 1)
+static void BM_MeeleAttackWave(benchmark::State& state){
+    bool batch = state.range(0) == 1;
+    const int n = 1024;
+    vector<int> a(n), b(n), out(n);
+    for(int i=0; i<n; ++i){
+        a[i] = i;
+        b[i] = n - i;
+    }
+    level3strategy level3;
+    strategyI* strategy = &level3;
+    benchmark::DoNotOptimize(strategy);     // the level is only known at runtime
+    Player player;
+    player.setStrategy(strategy);
+    for(auto _ : state){
+        if(batch){
+            player.playMeeleAttackBatch(a, b, out);
+        }else{
+            for(int i=0; i<n; ++i) out[i] = player.playMeeleAttack(a[i], b[i]);
+        }
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(batch ? "batch" : "one by one");
+}
+BENCHMARK(BM_MeeleAttackWave)->Arg(0)->Arg(1);
+
+// a strategy without its own batch kernel gets the default loop
+class doubleHitStrategy: public strategyI{
+public:
+    int meeleattack(int a, int b) override{
+        return 2 * a + b;
+    }
+    int rangeattack(int a, int b) override{
+        return a + 2 * b;
+    }
+    int getPlayingLevel() override{
+        return 4;
+    }
+};
+
+static void BM_DefaultMeeleAttackBatch(benchmark::State& state){
+    const int n = 1024;
+    vector<int> a(n, 1), b(n, 2), out(n);
+    doubleHitStrategy doubleHit;
+    strategyI* strategy = &doubleHit;
+    benchmark::DoNotOptimize(strategy);
+    Player player;
+    player.setStrategy(strategy);
+    for(auto _ : state){
+        player.playMeeleAttackBatch(a, b, out);
+        benchmark::DoNotOptimize(out.data());
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+}
+BENCHMARK(BM_DefaultMeeleAttackBatch);
+
+// A player object as a simulation would keep it: its own strategy and stats on the heap
+struct Fighter{
+    Player player;
+    unique_ptr<strategyI> strategy;
+    int power, bonus, damage;
+};
+
+static unique_ptr<strategyI> newLevel(int level){
+    if(level == 0) return make_unique<level1strategy>();
+    if(level == 1) return make_unique<level2strategy>();
+    return make_unique<level3strategy>();
+}
+
+// one meele wave over 1M players, heap objects in random order (Arg 0) or PlayerWorld
+static void BM_PopulationMeeleWave(benchmark::State& state){
+    const int n = 1 << 20;
+    mt19937 random(7);
+    level1strategy level1;
+    level2strategy level2;
+    level3strategy level3;
+    strategyI* shared[] = {&level1, &level2, &level3};
+    vector<unique_ptr<Fighter>> fighters;
+    PlayerWorld world;
+    for(int i=0; i<n; ++i){
+        int level = random() % 3, power = random() % 100, bonus = random() % 100;
+        if(state.range(0) == 0){
+            auto fighter = make_unique<Fighter>();
+            fighter->strategy = newLevel(level);
+            fighter->player.setStrategy(fighter->strategy.get());
+            fighter->power = power;
+            fighter->bonus = bonus;
+            fighters.push_back(move(fighter));
+        }else{
+            world.addPlayer(shared[level], power, bonus);
+        }
+    }
+    shuffle(fighters.begin(), fighters.end(), random);
+    for(auto _ : state){
+        if(state.range(0) == 0){
+            for(auto &fighter : fighters){
+                fighter->damage = fighter->player.playMeeleAttack(fighter->power, fighter->bonus);
+            }
+        }else{
+            world.meeleAttacks();
+        }
+        benchmark::ClobberMemory();
+    }
+    state.SetItemsProcessed(state.iterations() * n);
+    state.SetLabel(state.range(0) == 0 ? "objects" : "PlayerWorld");
+}
+BENCHMARK(BM_PopulationMeeleWave)->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+static void BM_PlayerWorldSetStrategy(benchmark::State& state){
+    const int n = 1 << 20;
+    mt19937 random(7);
+    level1strategy level1;
+    level2strategy level2;
+    level3strategy level3;
+    strategyI* shared[] = {&level1, &level2, &level3};
+    PlayerWorld world;
+    for(int i=0; i<n; ++i) world.addPlayer(shared[i % 3], i & 127, 1);
+    for(auto _ : state){
+        world.setStrategy(random() % n, shared[random() % 3]);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_PlayerWorldSetStrategy);
+
+// The strategy behind a mutex, what setStrategy would need without the epochs
+class LockedPlayer{
+    mutex lock;
+    shared_ptr<strategyI> strategy;
+
+public:
+    void setStrategy(shared_ptr<strategyI> curStrategy){
+        lock_guard<mutex> held(lock);
+        strategy = curStrategy;
+    }
+
+    int playMeeleAttack(int a, int b){
+        shared_ptr<strategyI> current;
+        {
+            lock_guard<mutex> held(lock);
+            current = strategy;
+        }
+        return current->meeleattack(a, b);
+    }
+};
+
+static ConcurrentPlayer concurrentPlayer(newLevel(0));
+static LockedPlayer lockedPlayer;
+
+// every thread attacks the same player, thread 0 also changes its level every 256 attacks
+static void BM_ConcurrentPlayMeeleAttack(benchmark::State& state){
+    int a = 1, b = 2;
+    long long attacks = 0;
+    for(auto _ : state){
+        if(state.thread_index() == 0 && (attacks & 255) == 0){
+            concurrentPlayer.setStrategy(newLevel((attacks >> 8) % 3));
+        }
+        benchmark::DoNotOptimize(a = concurrentPlayer.playMeeleAttack(a & 1023, b));
+        attacks++;
+    }
+    state.SetItemsProcessed(attacks);
+}
+BENCHMARK(BM_ConcurrentPlayMeeleAttack)->ThreadRange(1, 8)->UseRealTime();
+
+static void BM_LockedPlayMeeleAttack(benchmark::State& state){
+    if(state.thread_index() == 0) lockedPlayer.setStrategy(newLevel(0));
+    int a = 1, b = 2;
+    long long attacks = 0;
+    for(auto _ : state){
+        if(state.thread_index() == 0 && (attacks & 255) == 0){
+            lockedPlayer.setStrategy(newLevel((attacks >> 8) % 3));
+        }
+        benchmark::DoNotOptimize(a = lockedPlayer.playMeeleAttack(a & 1023, b));
+        attacks++;
+    }
+    state.SetItemsProcessed(attacks);
+}
+BENCHMARK(BM_LockedPlayMeeleAttack)->ThreadRange(1, 8)->UseRealTime();
@@ -0,0 +1,59 @@
+// Google Benchmark suite for TicTacToe: applying a move, checking a win and a whole headless game
+#include <benchmark/benchmark.h>
+#include <vector>
+#include "batch_runner.hpp"
+
+using namespace std;
+
+// Fills the board in row order and clears it again
+static void BM_InsertXY(benchmark::State& state){
+    int size = state.range(0);
+    Board board(size);
+    for(auto _ : state){
+        for(int x=0; x<size; ++x){
+            for(int y=0; y<size; ++y){
+                board.insertXY(x, y, (x + y) % 2 ? 'O' : 'X');
+            }
+        }
+        benchmark::DoNotOptimize(board.isFull());
+        board.clear();
+    }
+    state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_InsertXY)->Arg(3)->Arg(8)->Arg(32);
+
+static void BM_IsWinningMove(benchmark::State& state){
+    int size = state.range(0);
+    Board board(size);
+    for(int x=0; x<size; ++x){
+        for(int y=0; y<size; ++y){
+            if((x * size + y) % 3 != 0)  board.insertXY(x, y, (x + y) % 2 ? 'O' : 'X');
+        }
+    }
+    int x = 0, y = 0;
+    for(auto _ : state){
+        benchmark::DoNotOptimize(board.isWinningMove(x, y, 'X'));
+        if(++y == size){
+            y = 0;
+            x = x + 1 == size ? 0 : x + 1;
+        }
+    }
+}
+BENCHMARK(BM_IsWinningMove)->Arg(3)->Arg(8)->Arg(32);
+
+// Two random players, one iteration is one full game
+static void BM_RandomGame(benchmark::State& state){
+    int size = state.range(0);
+    RandomMoveProvider first(1), second(2);
+    vector<Player> seating;
+    seating.push_back(Player("player1", 'X', &first));
+    seating.push_back(Player("player2", 'O', &second));
+    Game game(seating, size);
+    BatchRunner runner;
+    for(auto _ : state){
+        BatchResult result = runner.run(game, 1);
+        benchmark::DoNotOptimize(result.ties);
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_RandomGame)->Arg(3)->Arg(8)->Arg(32);
@@ -0,0 +1,86 @@
+#ifndef LLD_BOUNDED_QUEUE
+#define LLD_BOUNDED_QUEUE
+#include <atomic>
+#include <memory>
+#include <cstddef>
+#include <utility>
+
+using namespace std;
+
+// Fixed size lock free queue for many producers and many consumers (Dmitry Vyukov's
+// bounded MPMC queue). Every cell has a sequence number telling whether it is free
+// for the push of this lap or holds a value for the pop of this lap, so a push or a
+// pop is one compare and swap on its own position. The size is rounded up to a power of two.
+template<typename T>
+class BoundedQueue{
+	struct Cell{
+		atomic<size_t> sequence;
+		T data;
+	};
+
+	unique_ptr<Cell[]> cells;
+	size_t mask;
+	alignas(64) atomic<size_t> enqueuePos;
+	alignas(64) atomic<size_t> dequeuePos;
+
+public:
+	BoundedQueue(size_t capacity){
+		size_t size = 2;
+		while(size < capacity)	size *= 2;
+		cells.reset(new Cell[size]);
+		mask = size - 1;
+		for(size_t i=0; i<size; ++i){
+			cells[i].sequence.store(i, memory_order_relaxed);
+		}
+		enqueuePos.store(0, memory_order_relaxed);
+		dequeuePos.store(0, memory_order_relaxed);
+	}
+
+	// false when the queue is full
+	bool tryPush(T&& value){
+		size_t pos = enqueuePos.load(memory_order_relaxed);
+		while(true){
+			Cell& cell = cells[pos & mask];
+			size_t sequence = cell.sequence.load(memory_order_acquire);
+			long long diff = (long long)sequence - (long long)pos;
+			if(diff == 0){
+				if(enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)){
+					cell.data = move(value);
+					cell.sequence.store(pos + 1, memory_order_release);
+					return true;
+				}
+			}else if(diff < 0){
+				return false;
+			}else{
+				pos = enqueuePos.load(memory_order_relaxed);
+			}
+		}
+	}
+
+	// false when the queue is empty
+	bool tryPop(T& value){
+		size_t pos = dequeuePos.load(memory_order_relaxed);
+		while(true){
+			Cell& cell = cells[pos & mask];
+			size_t sequence = cell.sequence.load(memory_order_acquire);
+			long long diff = (long long)sequence - (long long)(pos + 1);
+			if(diff == 0){
+				if(dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)){
+					value = move(cell.data);
+					cell.sequence.store(pos + mask + 1, memory_order_release);
+					return true;
+				}
+			}else if(diff < 0){
+				return false;
+			}else{
+				pos = dequeuePos.load(memory_order_relaxed);
+			}
+		}
+	}
+
+	size_t capacity(){
+		return mask + 1;
+	}
+};
+
+#endif
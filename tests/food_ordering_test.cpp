@@ -0,0 +1,46 @@
+// Checks of the food ordering system that ctest runs, a failed check exits with 1
+#include <iostream>
+#include <string>
+#include "order_manager.hpp"
+
+using namespace std;
+
+static int failures = 0;
+
+static void check(bool ok, const string& what){
+    if(!ok){
+        cout << "FAILED: " << what << endl;
+        failures++;
+    }
+}
+
+// Completing an order again by its handle must not free its slot a second time
+static void completeOrderTwice(){
+    ResturantMap resturantMap;
+    resturantMap.clear();
+    Resturant resturant("R", 5, 2);
+    resturant.add_to_menu("Dosa", 50);
+    resturantMap.add_resturant(resturant);
+    OrderManager orderManager;
+    Order promoted;
+
+    Order order = orderManager.place_order("user", "Dosa", "RATING");
+    check(order.getStatus() == PLACED, "order placed");
+    check(orderManager.complete_order(order, promoted), "first completion");
+    check(!orderManager.complete_order(order, promoted), "second completion is refused");
+    check(resturantMap["R"].getCurLimit() == 0, "slot released once");
+
+    Order first = orderManager.place_order("user", "Dosa", "RATING");
+    Order second = orderManager.place_order("user", "Dosa", "RATING");
+    check(first.getHandle() != second.getHandle(), "later orders get their own pool slots");
+    check(resturantMap["R"].getCurLimit() == 2, "both later orders hold a slot");
+    orderManager.complete_order(first, promoted);
+    orderManager.complete_order(second, promoted);
+    resturantMap.clear();
+}
+
+int main(){
+    completeOrderTwice();
+    if(failures == 0)   cout << "all checks passed" << endl;
+    return failures == 0 ? 0 : 1;
+}